@@ -1,6 +1,7 @@
 #define SWL_IMPLEMENTATION
 #include "swl.h"
 
+#define GLC_USE_FUNCTIONS
 #define GLC_IMPLEMENTATION
 #include "glc.h"
 
@@ -10,7 +11,7 @@ int main(void)
         return -1;
     }
 
-    GLCBackendConfig glc_config;
+    GLCBackendConfig glc_config = {0};
     glc_config.x11.display = swl_x11_get_display();
     GLCBackend *glc = glcCreateBackend(&glc_config);
 
@@ -20,9 +21,10 @@ int main(void)
     window_config.height = 600;
     window_config.is_visible = 1;
     window_config.is_resizable = 0;
-    swl_window *window = swl_create_window(&window_config);
+    // Same visual as the framebuffer config, presents need no conversion
+    swl_window *window = glcCreateSwlWindow(glc, &window_config);
 
-    GLCContextConfig context_config;
+    GLCContextConfig context_config = {0};
     context_config.x11.window = swl_x11_get_window(window);
     context_config.version.major = 3;
     context_config.version.minor = 3;
@@ -30,10 +32,12 @@ int main(void)
     GLCContext *context = glcCreateContext(glc, &context_config);
 
     glcMakeContextCurrent(glc, context);
+    glcSetSwapInterval(glc, context, -1);
+    const GLCFunctions *gl = glcGetFunctions(glc);
 
-    printf("GL_RENDERER: %s\n", glGetString(GL_RENDERER));
-    printf("GL_VERSION: %s\n", glGetString(GL_VERSION));
-    printf("GLSL_VERSION: %s\n", glGetString(GL_SHADING_LANGUAGE_VERSION));
+    printf("GL_RENDERER: %s\n", gl->GetString(GL_RENDERER));
+    printf("GL_VERSION: %s\n", gl->GetString(GL_VERSION));
+    printf("GLSL_VERSION: %s\n", gl->GetString(GL_SHADING_LANGUAGE_VERSION));
 
     swl_bool running = SWL_TRUE;
     swl_event event;
@@ -46,8 +50,8 @@ int main(void)
             }
         }
 
-        glClearColor(1.0f, 0.2f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);        
+        gl->ClearColor(1.0f, 0.2f, 0.1f, 1.0f);
+        gl->Clear(GL_COLOR_BUFFER_BIT);
         glcSwapBuffer(glc, context);
     }
 
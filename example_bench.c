@@ -0,0 +1,303 @@
+#define GLC_DISPLAY_SURFACELESS
+#define GLC_USE_CAPTURE
+#define GLC_USE_PRESENTER
+#define GLC_IMPLEMENTATION
+#include "glc.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define STATE_ITERATIONS 2000000
+#define SWITCH_ITERATIONS 20000
+#define CAPTURE_FRAMES 200
+#define CAPTURE_WIDTH 640
+#define CAPTURE_HEIGHT 480
+#define PRESENT_FRAMES 300
+#define PRESENT_WIDTH 640
+#define PRESENT_HEIGHT 480
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+// CPU time of the calling thread, unlike wall time it leaves out other threads sharing the cores
+static double thread_cpu_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+// Cheap state calls whose cost is mostly the driver's argument validation
+static double bench_state_calls(GLCBackend *glc, GLCContext *context)
+{
+    glcMakeContextCurrent(glc, context);
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    double start = now_ms();
+    for(int i = 0; i < STATE_ITERATIONS; ++i) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (i & 1) ? GL_LINEAR : GL_NEAREST);
+        glBlendFunc(GL_SRC_ALPHA, (i & 1) ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+        glDepthFunc((i & 1) ? GL_LESS : GL_LEQUAL);
+        glViewport(0, 0, 64 + (i & 1), 64);
+    }
+    glFinish();
+    double elapsed = now_ms() - start;
+
+    glDeleteTextures(1, &texture);
+    glcMakeContextCurrent(glc, NULL);
+    return elapsed;
+}
+
+// Alternate between two contexts with pending work, the release flush is paid on every switch
+static double bench_context_switch(GLCBackend *glc, GLCContext *a, GLCContext *b)
+{
+    double start = now_ms();
+    for(int i = 0; i < SWITCH_ITERATIONS; ++i) {
+        glcMakeContextCurrent(glc, (i & 1) ? a : b);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glFinish();
+    glcMakeContextCurrent(glc, NULL);
+    return now_ms() - start;
+}
+
+static void count_frame(const GLCCaptureFrame *frame, void *user_data)
+{
+    (void)frame;
+    ++*(int *)user_data;
+}
+
+// Ring capture, the frame ends with the swap and glcCaptureDeliver runs after
+// it. Both are on the render thread, the sinks may not be.
+static void bench_capture_ring(GLCBackend *glc, GLCContext *context, GLCCapture *capture, const char *sink)
+{
+    double start = now_ms(), cpu_start = thread_cpu_ms();
+    for(int i = 0; i < CAPTURE_FRAMES; ++i) {
+        glClearColor((float)(i & 1), 0.5f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glcCaptureFrame(capture);
+        glcSwapBuffer(glc, context);
+        glcCaptureDeliver(capture);
+    }
+    double total = (now_ms() - start) / CAPTURE_FRAMES;
+    double cpu = (thread_cpu_ms() - cpu_start) / CAPTURE_FRAMES;
+
+    GLCCaptureStats stats;
+    glcGetCaptureStats(capture, &stats);
+    glcDestroyCapture(capture);
+    printf("capture %dx%d ring, %s: %.3f ms/frame, render thread cpu %.3f ms (glcCaptureFrame %.3f ms, "
+            "glcCaptureDeliver %.3f ms), sinks %.3f ms (%llu stalls, %llu sink stalls, %llu overruns, %llu delivered)\n",
+            CAPTURE_WIDTH, CAPTURE_HEIGHT, sink, total, cpu,
+            (double)stats.total_cpu_ns / 1000000.0 / CAPTURE_FRAMES,
+            (double)stats.total_deliver_ns / 1000000.0 / CAPTURE_FRAMES,
+            (double)stats.total_sink_ns / 1000000.0 / CAPTURE_FRAMES,
+            stats.stalls, stats.sink_stalls, stats.overruns, stats.delivered);
+}
+
+// Render thread time per frame of a blocking glReadPixels against the pixel pack buffer ring
+static void bench_capture(GLCBackend *glc)
+{
+    GLCContextConfig context_config = {0};
+    context_config.version.major = 3;
+    context_config.version.minor = 3;
+    context_config.is_core_profile = 1;
+    GLCContext *context = glcCreateOffscreenContext(glc, &context_config, CAPTURE_WIDTH, CAPTURE_HEIGHT);
+    if(!context) return;
+    glcMakeContextCurrent(glc, context);
+
+    double start = now_ms(), cpu_start = thread_cpu_ms();
+    for(int i = 0; i < CAPTURE_FRAMES; ++i) {
+        glClearColor((float)(i & 1), 0.5f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glcSwapBuffer(glc, context);
+    }
+    glFinish();
+    printf("capture %dx%d no capture: %.3f ms/frame, render thread cpu %.3f ms\n", CAPTURE_WIDTH, CAPTURE_HEIGHT,
+            (now_ms() - start) / CAPTURE_FRAMES, (thread_cpu_ms() - cpu_start) / CAPTURE_FRAMES);
+
+    unsigned char *pixels = (unsigned char *)malloc(CAPTURE_WIDTH * CAPTURE_HEIGHT * 4);
+    start = now_ms();
+    cpu_start = thread_cpu_ms();
+    for(int i = 0; i < CAPTURE_FRAMES; ++i) {
+        glClearColor((float)(i & 1), 0.5f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glReadPixels(0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glcSwapBuffer(glc, context);
+    }
+    printf("capture %dx%d blocking readback: %.3f ms/frame, render thread cpu %.3f ms\n", CAPTURE_WIDTH, CAPTURE_HEIGHT,
+            (now_ms() - start) / CAPTURE_FRAMES, (thread_cpu_ms() - cpu_start) / CAPTURE_FRAMES);
+    free(pixels);
+
+    int delivered = 0;
+    GLCCapture *capture = glcCreateCapture(glc, context, CAPTURE_WIDTH, CAPTURE_HEIGHT, 3);
+    if(capture) {
+        glcCaptureSetCallback(capture, count_frame, &delivered);
+        bench_capture_ring(glc, context, capture, "callback");
+    }
+
+    // Every frame is copied into the mapped file
+    capture = glcCreateCapture(glc, context, CAPTURE_WIDTH, CAPTURE_HEIGHT, 3);
+    if(capture) {
+        if(glcCaptureSetFile(capture, "capture_bench.rgba", CAPTURE_FRAMES))
+            bench_capture_ring(glc, context, capture, "file sink");
+        else
+            glcDestroyCapture(capture);
+        remove("capture_bench.rgba");
+    }
+
+    glcMakeContextCurrent(glc, NULL);
+    glcDestroyContext(glc, context);
+}
+
+// Frame content is a few full screen clears, the red channel encodes the frame index
+static void draw_frame(int index)
+{
+    for(int i = 0; i < 16; ++i) {
+        glClearColor((float)(index & 0xff) / 255.0f, (float)i / 16.0f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+}
+
+// Render into a framebuffer object and blit it to the window on the calling
+// thread, the same GPU work the presenter splits across two threads
+static double bench_present_blit(GLCBackend *glc, GLCContext *window)
+{
+    PFNGLGENFRAMEBUFFERSPROC GenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)glcGetProcAddress(glc, "glGenFramebuffers");
+    PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)glcGetProcAddress(glc, "glDeleteFramebuffers");
+    PFNGLBINDFRAMEBUFFERPROC BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)glcGetProcAddress(glc, "glBindFramebuffer");
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC FramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)glcGetProcAddress(glc, "glFramebufferRenderbuffer");
+    PFNGLGENRENDERBUFFERSPROC GenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)glcGetProcAddress(glc, "glGenRenderbuffers");
+    PFNGLDELETERENDERBUFFERSPROC DeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)glcGetProcAddress(glc, "glDeleteRenderbuffers");
+    PFNGLBINDRENDERBUFFERPROC BindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)glcGetProcAddress(glc, "glBindRenderbuffer");
+    PFNGLRENDERBUFFERSTORAGEPROC RenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)glcGetProcAddress(glc, "glRenderbufferStorage");
+    PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)glcGetProcAddress(glc, "glBlitFramebuffer");
+
+    glcMakeContextCurrent(glc, window);
+    GLuint framebuffer, renderbuffers[2];
+    GenFramebuffers(1, &framebuffer);
+    GenRenderbuffers(2, renderbuffers);
+    BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    BindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, PRESENT_WIDTH, PRESENT_HEIGHT);
+    BindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, PRESENT_WIDTH, PRESENT_HEIGHT);
+    FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+    FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+
+    double start = now_ms();
+    for(int i = 0; i < PRESENT_FRAMES; ++i) {
+        BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        draw_frame(i);
+        BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        BlitFramebuffer(0, 0, PRESENT_WIDTH, PRESENT_HEIGHT, 0, 0, PRESENT_WIDTH, PRESENT_HEIGHT,
+                GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glcSwapBuffer(glc, window);
+    }
+    glFinish();
+    double elapsed = (now_ms() - start) / PRESENT_FRAMES;
+
+    BindFramebuffer(GL_FRAMEBUFFER, 0);
+    DeleteFramebuffers(1, &framebuffer);
+    DeleteRenderbuffers(2, renderbuffers);
+    glcMakeContextCurrent(glc, NULL);
+    return elapsed;
+}
+
+// Frame rate of rendering and swapping on one thread against handing the frames
+// to the present thread. The pbuffer context stands in for the window.
+static void bench_presenter(GLCBackend *glc)
+{
+    GLCContextConfig context_config = {0};
+    context_config.version.major = 3;
+    context_config.version.minor = 3;
+    context_config.is_core_profile = 1;
+    GLCContext *window = glcCreateOffscreenContext(glc, &context_config, PRESENT_WIDTH, PRESENT_HEIGHT);
+    if(!window) return;
+
+    glcMakeContextCurrent(glc, window);
+    double start = now_ms();
+    for(int i = 0; i < PRESENT_FRAMES; ++i) {
+        draw_frame(i);
+        glcSwapBuffer(glc, window);
+    }
+    glFinish();
+    double direct = (now_ms() - start) / PRESENT_FRAMES;
+    glcMakeContextCurrent(glc, NULL);
+    double blit = bench_present_blit(glc, window);
+
+    GLCPresenter *presenter = glcCreatePresenter(glc, window, &context_config, PRESENT_WIDTH, PRESENT_HEIGHT, 2);
+    if(presenter) {
+        start = now_ms();
+        int rendered = 0;
+        for(; rendered < PRESENT_FRAMES; ++rendered) {
+            if(!glcPresenterBeginFrame(presenter)) break;
+            glViewport(0, 0, PRESENT_WIDTH, PRESENT_HEIGHT);
+            draw_frame(rendered);
+            glcPresenterEndFrame(presenter);
+        }
+        glFinish();
+        double threaded = (now_ms() - start) / PRESENT_FRAMES;
+        glcDestroyPresenter(presenter);
+
+        // Queued frames are dropped on destroy, the window shows one of the last ones
+        unsigned char pixel[4] = {0};
+        glcMakeContextCurrent(glc, window);
+        glReadPixels(PRESENT_WIDTH / 2, PRESENT_HEIGHT / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        glcMakeContextCurrent(glc, NULL);
+        printf("present %dx%d: same thread %.3f ms/frame, same thread with blit %.3f ms/frame, "
+                "present thread %.3f ms/frame (%d rendered, window shows frame %d mod 256)\n",
+                PRESENT_WIDTH, PRESENT_HEIGHT, direct, blit, threaded, rendered, pixel[0]);
+    }
+
+    glcDestroyContext(glc, window);
+}
+
+static void run(GLCBackend *glc, char use_no_error, char use_no_release_flush)
+{
+    GLCContextConfig context_config = {0};
+    context_config.version.major = 3;
+    context_config.version.minor = 3;
+    context_config.is_core_profile = 1;
+    context_config.use_no_error = use_no_error;
+    context_config.use_no_release_flush = use_no_release_flush;
+
+    GLCContext *a = glcCreateOffscreenContext(glc, &context_config, 64, 64);
+    GLCContext *b = glcCreateOffscreenContext(glc, &context_config, 64, 64);
+    if(!a || !b) {
+        glcDestroyContext(glc, a);
+        glcDestroyContext(glc, b);
+        return;
+    }
+
+    printf("no_error=%d no_release_flush=%d: state calls %.2f ms, context switches %.2f ms\n",
+            use_no_error, use_no_release_flush, bench_state_calls(glc, a), bench_context_switch(glc, a, b));
+
+    glcDestroyContext(glc, a);
+    glcDestroyContext(glc, b);
+}
+
+int main(void)
+{
+    GLCBackendConfig glc_config = {0};
+    GLCBackend *glc = glcCreateBackend(&glc_config);
+    if(!glc) {
+        return -1;
+    }
+
+    run(glc, 0, 0);
+    run(glc, 1, 0);
+    run(glc, 0, 1);
+    run(glc, 1, 1);
+    bench_capture(glc);
+    bench_presenter(glc);
+
+    glcDestroyBackend(glc);
+}
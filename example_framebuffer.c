@@ -0,0 +1,53 @@
+#define SWL_IMPLEMENTATION
+#include "swl.h"
+
+int main(void)
+{
+    if(!swl_init()) {
+        return -1;
+    }
+
+    swl_window_config window_config;
+    window_config.title = "Framebuffer";
+    window_config.width = 640;
+    window_config.height = 480;
+    window_config.is_visible = SWL_TRUE;
+    window_config.is_resizable = SWL_FALSE;
+    swl_window *window = swl_create_window(&window_config);
+
+    swl_framebuffer *framebuffer = swl_create_framebuffer(window, 640, 480);
+    if(!framebuffer) {
+        swl_destroy_window(window);
+        swl_deinit();
+        return -1;
+    }
+    printf("Shared: %s\n", swl_is_framebuffer_shared(framebuffer) ? "yes" : "no");
+
+    swl_bool running = SWL_TRUE;
+    swl_event event;
+    swl_uint32 frame = 0;
+    while(running) {
+        swl_poll_window_events();
+        while(swl_shift_event(&event)) {
+            if(event.type == SWL_EVENT_WINDOW_CLOSED) running = SWL_FALSE;
+        }
+
+        swl_uint32 stride;
+        swl_uint8 *pixels = (swl_uint8 *)swl_acquire_framebuffer(framebuffer, &stride, SWL_TRUE);
+        if(!pixels) break;
+
+        // Only a moving 64x64 square changes, the rest of the frame is kept from before
+        swl_rect square = { (int)(frame * 4 % (640 - 64)), 208, 64, 64 };
+        for(swl_uint32 y = 0; y < square.height; ++y) {
+            swl_uint32 *row = (swl_uint32 *)(pixels + (square.y + y) * stride) + square.x;
+            for(swl_uint32 x = 0; x < square.width; ++x) row[x] = (frame * 3 & 0xff) << 16 | x << 10 | y << 2;
+        }
+        swl_present_framebuffer(framebuffer, &square, 1);
+        ++frame;
+    }
+
+    swl_destroy_framebuffer(framebuffer);
+    swl_destroy_window(window);
+    swl_deinit();
+    return 0;
+}
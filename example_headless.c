@@ -0,0 +1,58 @@
+#define GLC_DISPLAY_SURFACELESS
+#define GLC_IMPLEMENTATION
+#define GLC_USE_PROFILER
+#include "glc.h"
+
+int main(void)
+{
+    GLCBackendConfig glc_config = {0};
+    GLCBackend *glc = glcCreateBackend(&glc_config);
+    if(!glc) {
+        return -1;
+    }
+
+    GLCContextConfig context_config = {0};
+    context_config.version.major = 3;
+    context_config.version.minor = 3;
+    context_config.is_core_profile = 1;
+    GLCContext *context = glcCreateOffscreenContext(glc, &context_config, 64, 64);
+    if(!context) {
+        glcDestroyBackend(glc);
+        return -1;
+    }
+
+    glcMakeContextCurrent(glc, context);
+
+    printf("GL_RENDERER: %s\n", glGetString(GL_RENDERER));
+    printf("GL_VERSION: %s\n", glGetString(GL_VERSION));
+
+    GLCProfiler *profiler = glcCreateProfiler(glc, context, 16);
+
+    unsigned char pixel[4] = {0};
+    for(int i = 0; i < 8; ++i) {
+        GLC_PROFILER_BEGIN_FRAME(profiler);
+        GLC_PROFILER_BEGIN_ZONE(profiler, "clear");
+        glClearColor(1.0f, 0.2f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        GLC_PROFILER_END_ZONE(profiler);
+        GLC_PROFILER_BEGIN_ZONE(profiler, "readback");
+        glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        GLC_PROFILER_END_ZONE(profiler);
+        GLC_PROFILER_END_FRAME(profiler);
+    }
+    printf("Pixel: %d %d %d %d\n", pixel[0], pixel[1], pixel[2], pixel[3]);
+
+    GLCProfilerFrame frame;
+    if(glcProfilerGetFrame(profiler, &frame)) {
+        printf("Frame %llu: cpu %llu ns, gpu %llu ns\n", frame.index, frame.cpu_ns, frame.gpu_ns);
+        for(int i = 1; i < frame.zone_count; ++i)
+            printf("  %s: cpu %llu ns, gpu %llu ns\n", frame.zones[i].name,
+                    frame.zones[i].cpu_end_ns - frame.zones[i].cpu_begin_ns,
+                    frame.zones[i].gpu_end_ns - frame.zones[i].gpu_begin_ns);
+    }
+    glcDestroyProfiler(profiler);
+
+    glcMakeContextCurrent(glc, NULL);
+    glcDestroyContext(glc, context);
+    glcDestroyBackend(glc);
+}
@@ -18,7 +18,7 @@ int main(void)
     swl_bool running = SWL_TRUE;
     swl_event event;
     while(running) {
-        swl_poll_window_events();
+        swl_wait_events();
         while(swl_shift_event(&event)) {
             if(event.type == SWL_EVENT_WINDOW_CLOSED) {
                 running = SWL_FALSE;
@@ -12,20 +12,42 @@
         #define GLC_DISPLAY_WIN32 // win32 display will use wgl backend
         #define GLC_DISPLAY_X11 // X11 will use GLX backend
         #define GLC_DISPLAY_ANDROID 
-        #define GLC_DISPLAY_WAYLAND
+        #define GLC_DISPLAY_WAYLAND // Wayland will use EGL backend
+        #define GLC_DISPLAY_SURFACELESS // no display system, EGL on EGL_MESA_platform_surfaceless
 
     Optionally provide the following defines with your own implementations:
         #define GLC_LOG_MESSAGE(message) // If you define this, GLC will log message when error happened
         #define GLC_MALLOC // malloc. both free and malloc should be defined
         #define GLC_FREE // free. both free and malloc should be defined
+        #define GLC_USE_EGL // with GLC_DISPLAY_X11, create contexts through EGL instead of GLX
+        #define GLC_USE_FUNCTIONS // declare GLCFunctions, a table of every OpenGL core profile entry point
+        #define GLC_USE_PROFILER // GPU timer query zones, GLC_PROFILER_* macros expand to nothing otherwise
+        #define GLC_PROFILER_LATENCY // frames between recording and readback, 4 by default
+        #define GLC_USE_PRESENTER // GLCPresenter, swaps on a present thread, link with pthread
+        #define GLC_USE_CAPTURE // GLCCapture, asynchronous framebuffer readback through pixel pack buffers, link with pthread
+
+    The implementation needs POSIX.1-2008 on Linux. Under strict -std=c99/c11
+    it defines _POSIX_C_SOURCE 200809L itself when no feature test macro is
+    set, so include glc.h before any system header in the implementation file,
+    or define _POSIX_C_SOURCE (or _GNU_SOURCE) on the command line.
 
     Link with the following system libraries:
     - on Linux with GLC_DISPLAY_X11: X11, GL
+    - on Linux with GLC_DISPLAY_X11 and GLC_USE_EGL: X11, EGL, GL
+    - on Linux with GLC_DISPLAY_WAYLAND: EGL, GL (wayland-client and wayland-egl for the window)
+    - on Linux with GLC_DISPLAY_SURFACELESS: EGL, GL
 
 */
 #ifndef GLC_H_
 #define GLC_H_
 
+// clock_gettime and ftruncate are POSIX, strict -std=c99/c11 hides them otherwise.
+// GNU modes already expose them, defining it there would hide MAP_POPULATE
+#if defined(GLC_IMPLEMENTATION) && !defined(_WIN32) && defined(__STRICT_ANSI__) && \
+    !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE) && !defined(_XOPEN_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <string.h> // strstr, 
 
 #ifndef GLC_LOG_MESSAGE
@@ -48,11 +70,18 @@
 #endif
 
 #ifdef __linux__
-#if !defined(GLC_DISPLAY_X11) || !defined(GLC_DISPLAY_WAYLAND)
+#if !defined(GLC_DISPLAY_X11) && !defined(GLC_DISPLAY_WAYLAND) && !defined(GLC_DISPLAY_SURFACELESS)
 #define GLC_DISPLAY_X11
 #endif
 #endif
 
+// Context creation library picked from the display system
+#if defined(GLC_DISPLAY_X11) && !defined(GLC_USE_EGL)
+#define GLC_BACKEND_GLX
+#elif defined(GLC_DISPLAY_X11) || defined(GLC_DISPLAY_WAYLAND) || defined(GLC_DISPLAY_SURFACELESS)
+#define GLC_BACKEND_EGL
+#endif
+
 #ifdef GLC_DISPLAY_X11
 typedef struct _XDisplay Display;
 typedef unsigned long XID;
@@ -68,32 +97,77 @@ typedef XID Window;
 #endif
 
 #ifdef GLC_DISPLAY_WAYLAND
-#error "Not implemented yet"
+struct wl_display;
+// Created from a wl_surface with wl_egl_window_create() from wayland-egl
+struct wl_egl_window;
 #endif
 
 typedef struct GLCBackend GLCBackend;
 
+typedef struct GLCFramebufferConfig {
+    int red_bits, green_bits, blue_bits, alpha_bits;
+    int depth_bits, stencil_bits;
+    // 0 disables multisampling
+    int samples;
+    char use_srgb;
+} GLCFramebufferConfig;
+
 typedef struct GLCBackendConfig {
+    // Requested framebuffer format, the closest available config is chosen.
+    // NULL requests RGBA8 with 24-bit depth, 8-bit stencil and no multisampling.
+    const GLCFramebufferConfig *framebuffer;
+    // File that remembers the chosen config ID so later launches skip the
+    // enumeration. NULL disables the cache.
+    const char *config_cache_path;
+
 #ifdef GLC_DISPLAY_X11
     struct {
         Display *display;
     } x11;
 #endif
+#ifdef GLC_DISPLAY_WAYLAND
+    struct {
+        struct wl_display *display;
+    } wayland;
+#endif
 #ifdef GLC_DISPLAY_WIN32
     struct {
         HINSTANCE hInstance;
     } win32;
 #endif
+#ifdef GLC_BACKEND_EGL
+    struct {
+        // Choose an EGL config renderable with OpenGL ES instead of desktop OpenGL
+        char use_opengles;
+    } egl;
+#endif
 } GLCBackendConfig;
 
 typedef struct GLCContext GLCContext;
 
+// Same handle as GLsync
+typedef struct __GLsync *GLCFence;
+// Generic function pointer, cast to the matching PFN type before calling
+typedef void (*GLCProc)(void);
+
+// Counters of glcMakeContextCurrent calls made on the calling thread
+typedef struct GLCMakeCurrentStats {
+    unsigned long long binds;
+    unsigned long long skipped;
+} GLCMakeCurrentStats;
+
 typedef struct GLCContextConfig {
 #ifdef GLC_DISPLAY_X11
     struct {
         Window window;
     } x11;
 #endif
+#ifdef GLC_DISPLAY_WAYLAND
+    struct {
+        // Resize it with wl_egl_window_resize(), the surface follows on the next swap
+        struct wl_egl_window *window;
+    } wayland;
+#endif
 #ifdef GLC_DISPLAY_WIN32
     struct {
         HWND hWnd;
@@ -105,10 +179,20 @@ typedef struct GLCContextConfig {
         int minor;
     } version;
 
+    // Textures, buffers and other objects are shared with this context when set
+    GLCContext *share_with;
+
     char use_debug_context;
     char use_opengles;
     char is_backward_compatible;
     char is_core_profile;
+    // Skip the driver's per-call error checking, errors become undefined behavior.
+    // Ignored for debug contexts and when the extension is missing. Shared
+    // contexts have to agree on this flag.
+    char use_no_error;
+    // Don't flush when the context stops being current, saves a flush per
+    // context switch. Ignored when the extension is missing.
+    char use_no_release_flush;
 } GLCContextConfig;
 
 GLCDEF GLCBackend *glcCreateBackend(const GLCBackendConfig *config);
@@ -116,18 +200,990 @@ GLCDEF void glcDestroyBackend(GLCBackend *backend);
 
 GLCDEF GLCContext *glcCreateContext(GLCBackend *backend, const GLCContextConfig *config);
 GLCDEF void glcDestroyContext(GLCBackend *backend, GLCContext *context);
+// Binding the context already current on the calling thread is skipped. The
+// tracking only sees binds made through GLC.
 GLCDEF void glcMakeContextCurrent(GLCBackend *backend, GLCContext* context);
+GLCDEF GLCContext *glcGetCurrentContext(void);
+GLCDEF void glcGetMakeCurrentStats(GLCMakeCurrentStats *stats);
 GLCDEF void glcSwapBuffer(GLCBackend *backend, GLCContext *context);
+// Swap telling the compositor only these rectangles changed. rects holds
+// x, y, width, height per rectangle with the origin at the bottom left.
+// Without damage support the whole buffer is presented.
+GLCDEF void glcSwapBufferWithDamage(GLCBackend *backend, GLCContext *context, const int *rects, int rect_count);
+// 0 disables vsync, N waits for N vblanks per swap and a negative interval
+// requests adaptive vsync (late swaps tear). Without tear support a negative
+// interval falls back to its absolute value. Returns 0 if the interval could not be applied.
+GLCDEF int glcSetSwapInterval(GLCBackend *backend, GLCContext *context, int interval);
+// Interval in effect for the context, negative when late swaps tear
+GLCDEF int glcGetSwapInterval(GLCBackend *backend, GLCContext *context);
+
+// Present feedback of the last swap that reached the screen
+typedef struct GLCFrameTiming {
+    // Microseconds on the driver's clock (CLOCK_MONOTONIC on Linux) when the swap completed
+    long long ust;
+    // Vblank counter at completion
+    long long msc;
+    // Number of completed swaps
+    long long sbc;
+    // Swaps issued through GLC that haven't completed yet
+    long long pending;
+    // Vblanks missed since the context was created, counted against the swap interval
+    long long missed_vblanks;
+    // Set when the driver has no present feedback and the values come from
+    // the CPU clock around glcSwapBuffer: msc counts one vblank per expected
+    // refresh and missed_vblanks counts swaps much later than the average
+    char is_estimated;
+} GLCFrameTiming;
+
+// Returns 0 on invalid arguments
+GLCDEF int glcGetFrameTiming(GLCBackend *backend, GLCContext *context, GLCFrameTiming *timing);
+// Swap once the vblank counter reaches target_msc, or when msc % divisor ==
+// remainder after that if divisor is non zero. Returns the sbc the swap will
+// complete as, or -1 if the driver can't schedule swaps and the buffers were
+// swapped right away.
+GLCDEF long long glcSwapBufferAtMsc(GLCBackend *backend, GLCContext *context,
+        long long target_msc, long long divisor, long long remainder);
+// Present a group of windows once per frame. Every context but the last swaps
+// without waiting for vblank and the last one paces the frame with its swap
+// interval, so N windows don't run at refresh rate / N. The other windows keep
+// interval 0 until they are swapped on their own again and may tear without a
+// compositor. GLX swaps without binding anything. EGL binds each context for
+// its swap and restores the context that was current before the call. When
+// timings isn't NULL it receives glcGetFrameTiming of every context.
+GLCDEF void glcSwapBuffers(GLCBackend *backend, GLCContext **contexts, int count, GLCFrameTiming *timings);
+
+// Context without a window for loader threads, backed by a pbuffer when the
+// framebuffer config supports it and surfaceless otherwise. Set
+// config->share_with to upload into objects used by another context.
+GLCDEF GLCContext *glcCreateWorkerContext(GLCBackend *backend, const GLCContextConfig *config);
+// Windowless context rendering into a width x height pbuffer. Without pbuffer
+// support the context is surfaceless and has no default framebuffer, render
+// into a framebuffer object instead.
+GLCDEF GLCContext *glcCreateOffscreenContext(GLCBackend *backend, const GLCContextConfig *config,
+        int width, int height);
+
+// Fences hand work over between shared contexts: create one on the producing
+// context after the uploads, then wait on it from the consuming context.
+// A context must be current on the calling thread.
+GLCDEF GLCFence glcCreateFence(GLCBackend *backend);
+// Make the GPU wait for the fence without blocking the calling thread
+GLCDEF void glcWaitFence(GLCBackend *backend, GLCFence fence);
+// Block the calling thread, returns 1 once signaled and 0 on timeout or error
+GLCDEF int glcClientWaitFence(GLCBackend *backend, GLCFence fence, unsigned long long timeout_ns);
+GLCDEF void glcDestroyFence(GLCBackend *backend, GLCFence fence);
+
+// Address of an OpenGL or extension entry point. Core names are answered
+// from the GLCFunctions table once it has been loaded.
+GLCDEF GLCProc glcGetProcAddress(GLCBackend *backend, const char *name);
+
+#ifdef GLC_DISPLAY_X11
+// Visual of the backend's framebuffer config. Windows created with another
+// visual get their pixels converted by the server on every present.
+// Returns 0 on invalid arguments.
+GLCDEF int glcGetX11Visual(GLCBackend *backend, unsigned long *visual_id, int *depth);
+#endif
+
+// Include swl.h before glc.h to get a window matching the backend's visual.
+// The backend has to be created on swl_x11_get_display().
+#if defined(SWL_H_) && defined(SWL_DISPLAY_X11) && defined(GLC_DISPLAY_X11)
+GLCDEF swl_window *glcCreateSwlWindow(GLCBackend *backend, const swl_window_config *config);
+#endif
+
+#ifdef GLC_USE_FUNCTIONS
+#include <GL/gl.h>
+
+// OpenGL 1.0 - 4.6 core profile entry points, generated from glcorearb.h
+#define GLC_GL_FUNCTIONS(X) \
+    /* 1.0 */ \
+    X(void, CullFace, (GLenum mode)) \
+    X(void, FrontFace, (GLenum mode)) \
+    X(void, Hint, (GLenum target, GLenum mode)) \
+    X(void, LineWidth, (GLfloat width)) \
+    X(void, PointSize, (GLfloat size)) \
+    X(void, PolygonMode, (GLenum face, GLenum mode)) \
+    X(void, Scissor, (GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, TexParameterf, (GLenum target, GLenum pname, GLfloat param)) \
+    X(void, TexParameterfv, (GLenum target, GLenum pname, const GLfloat *params)) \
+    X(void, TexParameteri, (GLenum target, GLenum pname, GLint param)) \
+    X(void, TexParameteriv, (GLenum target, GLenum pname, const GLint *params)) \
+    X(void, TexImage1D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)) \
+    X(void, DrawBuffer, (GLenum buf)) \
+    X(void, Clear, (GLbitfield mask)) \
+    X(void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)) \
+    X(void, ClearStencil, (GLint s)) \
+    X(void, ClearDepth, (GLdouble depth)) \
+    X(void, StencilMask, (GLuint mask)) \
+    X(void, ColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)) \
+    X(void, DepthMask, (GLboolean flag)) \
+    X(void, Disable, (GLenum cap)) \
+    X(void, Enable, (GLenum cap)) \
+    X(void, Finish, (void)) \
+    X(void, Flush, (void)) \
+    X(void, BlendFunc, (GLenum sfactor, GLenum dfactor)) \
+    X(void, LogicOp, (GLenum opcode)) \
+    X(void, StencilFunc, (GLenum func, GLint ref, GLuint mask)) \
+    X(void, StencilOp, (GLenum fail, GLenum zfail, GLenum zpass)) \
+    X(void, DepthFunc, (GLenum func)) \
+    X(void, PixelStoref, (GLenum pname, GLfloat param)) \
+    X(void, PixelStorei, (GLenum pname, GLint param)) \
+    X(void, ReadBuffer, (GLenum src)) \
+    X(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)) \
+    X(void, GetBooleanv, (GLenum pname, GLboolean *data)) \
+    X(void, GetDoublev, (GLenum pname, GLdouble *data)) \
+    X(GLenum, GetError, (void)) \
+    X(void, GetFloatv, (GLenum pname, GLfloat *data)) \
+    X(void, GetIntegerv, (GLenum pname, GLint *data)) \
+    X(const GLubyte *, GetString, (GLenum name)) \
+    X(void, GetTexImage, (GLenum target, GLint level, GLenum format, GLenum type, void *pixels)) \
+    X(void, GetTexParameterfv, (GLenum target, GLenum pname, GLfloat *params)) \
+    X(void, GetTexParameteriv, (GLenum target, GLenum pname, GLint *params)) \
+    X(void, GetTexLevelParameterfv, (GLenum target, GLint level, GLenum pname, GLfloat *params)) \
+    X(void, GetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint *params)) \
+    X(GLboolean, IsEnabled, (GLenum cap)) \
+    X(void, DepthRange, (GLdouble n, GLdouble f)) \
+    X(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height)) \
+    /* 1.1 */ \
+    X(void, DrawArrays, (GLenum mode, GLint first, GLsizei count)) \
+    X(void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices)) \
+    X(void, GetPointerv, (GLenum pname, void **params)) \
+    X(void, PolygonOffset, (GLfloat factor, GLfloat units)) \
+    X(void, CopyTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border)) \
+    X(void, CopyTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)) \
+    X(void, CopyTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width)) \
+    X(void, CopyTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, TexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)) \
+    X(void, BindTexture, (GLenum target, GLuint texture)) \
+    X(void, DeleteTextures, (GLsizei n, const GLuint *textures)) \
+    X(void, GenTextures, (GLsizei n, GLuint *textures)) \
+    X(GLboolean, IsTexture, (GLuint texture)) \
+    /* 1.2 */ \
+    X(void, DrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices)) \
+    X(void, TexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels)) \
+    X(void, CopyTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    /* 1.3 */ \
+    X(void, ActiveTexture, (GLenum texture)) \
+    X(void, SampleCoverage, (GLfloat value, GLboolean invert)) \
+    X(void, CompressedTexImage3D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, GetCompressedTexImage, (GLenum target, GLint level, void *img)) \
+    /* 1.4 */ \
+    X(void, BlendFuncSeparate, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)) \
+    X(void, MultiDrawArrays, (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount)) \
+    X(void, MultiDrawElements, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount)) \
+    X(void, PointParameterf, (GLenum pname, GLfloat param)) \
+    X(void, PointParameterfv, (GLenum pname, const GLfloat *params)) \
+    X(void, PointParameteri, (GLenum pname, GLint param)) \
+    X(void, PointParameteriv, (GLenum pname, const GLint *params)) \
+    X(void, BlendColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)) \
+    X(void, BlendEquation, (GLenum mode)) \
+    /* 1.5 */ \
+    X(void, GenQueries, (GLsizei n, GLuint *ids)) \
+    X(void, DeleteQueries, (GLsizei n, const GLuint *ids)) \
+    X(GLboolean, IsQuery, (GLuint id)) \
+    X(void, BeginQuery, (GLenum target, GLuint id)) \
+    X(void, EndQuery, (GLenum target)) \
+    X(void, GetQueryiv, (GLenum target, GLenum pname, GLint *params)) \
+    X(void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint *params)) \
+    X(void, GetQueryObjectuiv, (GLuint id, GLenum pname, GLuint *params)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer)) \
+    X(void, DeleteBuffers, (GLsizei n, const GLuint *buffers)) \
+    X(void, GenBuffers, (GLsizei n, GLuint *buffers)) \
+    X(GLboolean, IsBuffer, (GLuint buffer)) \
+    X(void, BufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage)) \
+    X(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data)) \
+    X(void, GetBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, void *data)) \
+    X(void *, MapBuffer, (GLenum target, GLenum access)) \
+    X(GLboolean, UnmapBuffer, (GLenum target)) \
+    X(void, GetBufferParameteriv, (GLenum target, GLenum pname, GLint *params)) \
+    X(void, GetBufferPointerv, (GLenum target, GLenum pname, void **params)) \
+    /* 2.0 */ \
+    X(void, BlendEquationSeparate, (GLenum modeRGB, GLenum modeAlpha)) \
+    X(void, DrawBuffers, (GLsizei n, const GLenum *bufs)) \
+    X(void, StencilOpSeparate, (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)) \
+    X(void, StencilFuncSeparate, (GLenum face, GLenum func, GLint ref, GLuint mask)) \
+    X(void, StencilMaskSeparate, (GLenum face, GLuint mask)) \
+    X(void, AttachShader, (GLuint program, GLuint shader)) \
+    X(void, BindAttribLocation, (GLuint program, GLuint index, const GLchar *name)) \
+    X(void, CompileShader, (GLuint shader)) \
+    X(GLuint, CreateProgram, (void)) \
+    X(GLuint, CreateShader, (GLenum type)) \
+    X(void, DeleteProgram, (GLuint program)) \
+    X(void, DeleteShader, (GLuint shader)) \
+    X(void, DetachShader, (GLuint program, GLuint shader)) \
+    X(void, DisableVertexAttribArray, (GLuint index)) \
+    X(void, EnableVertexAttribArray, (GLuint index)) \
+    X(void, GetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)) \
+    X(void, GetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)) \
+    X(void, GetAttachedShaders, (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders)) \
+    X(GLint, GetAttribLocation, (GLuint program, const GLchar *name)) \
+    X(void, GetProgramiv, (GLuint program, GLenum pname, GLint *params)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum pname, GLint *params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)) \
+    X(void, GetShaderSource, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source)) \
+    X(GLint, GetUniformLocation, (GLuint program, const GLchar *name)) \
+    X(void, GetUniformfv, (GLuint program, GLint location, GLfloat *params)) \
+    X(void, GetUniformiv, (GLuint program, GLint location, GLint *params)) \
+    X(void, GetVertexAttribdv, (GLuint index, GLenum pname, GLdouble *params)) \
+    X(void, GetVertexAttribfv, (GLuint index, GLenum pname, GLfloat *params)) \
+    X(void, GetVertexAttribiv, (GLuint index, GLenum pname, GLint *params)) \
+    X(void, GetVertexAttribPointerv, (GLuint index, GLenum pname, void **pointer)) \
+    X(GLboolean, IsProgram, (GLuint program)) \
+    X(GLboolean, IsShader, (GLuint shader)) \
+    X(void, LinkProgram, (GLuint program)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)) \
+    X(void, UseProgram, (GLuint program)) \
+    X(void, Uniform1f, (GLint location, GLfloat v0)) \
+    X(void, Uniform2f, (GLint location, GLfloat v0, GLfloat v1)) \
+    X(void, Uniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2)) \
+    X(void, Uniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)) \
+    X(void, Uniform1i, (GLint location, GLint v0)) \
+    X(void, Uniform2i, (GLint location, GLint v0, GLint v1)) \
+    X(void, Uniform3i, (GLint location, GLint v0, GLint v1, GLint v2)) \
+    X(void, Uniform4i, (GLint location, GLint v0, GLint v1, GLint v2, GLint v3)) \
+    X(void, Uniform1fv, (GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, Uniform2fv, (GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, Uniform3fv, (GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, Uniform4fv, (GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, Uniform1iv, (GLint location, GLsizei count, const GLint *value)) \
+    X(void, Uniform2iv, (GLint location, GLsizei count, const GLint *value)) \
+    X(void, Uniform3iv, (GLint location, GLsizei count, const GLint *value)) \
+    X(void, Uniform4iv, (GLint location, GLsizei count, const GLint *value)) \
+    X(void, UniformMatrix2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ValidateProgram, (GLuint program)) \
+    X(void, VertexAttrib1d, (GLuint index, GLdouble x)) \
+    X(void, VertexAttrib1dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttrib1f, (GLuint index, GLfloat x)) \
+    X(void, VertexAttrib1fv, (GLuint index, const GLfloat *v)) \
+    X(void, VertexAttrib1s, (GLuint index, GLshort x)) \
+    X(void, VertexAttrib1sv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttrib2d, (GLuint index, GLdouble x, GLdouble y)) \
+    X(void, VertexAttrib2dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttrib2f, (GLuint index, GLfloat x, GLfloat y)) \
+    X(void, VertexAttrib2fv, (GLuint index, const GLfloat *v)) \
+    X(void, VertexAttrib2s, (GLuint index, GLshort x, GLshort y)) \
+    X(void, VertexAttrib2sv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttrib3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z)) \
+    X(void, VertexAttrib3dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttrib3f, (GLuint index, GLfloat x, GLfloat y, GLfloat z)) \
+    X(void, VertexAttrib3fv, (GLuint index, const GLfloat *v)) \
+    X(void, VertexAttrib3s, (GLuint index, GLshort x, GLshort y, GLshort z)) \
+    X(void, VertexAttrib3sv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttrib4Nbv, (GLuint index, const GLbyte *v)) \
+    X(void, VertexAttrib4Niv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttrib4Nsv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttrib4Nub, (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w)) \
+    X(void, VertexAttrib4Nubv, (GLuint index, const GLubyte *v)) \
+    X(void, VertexAttrib4Nuiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttrib4Nusv, (GLuint index, const GLushort *v)) \
+    X(void, VertexAttrib4bv, (GLuint index, const GLbyte *v)) \
+    X(void, VertexAttrib4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w)) \
+    X(void, VertexAttrib4dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttrib4f, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)) \
+    X(void, VertexAttrib4fv, (GLuint index, const GLfloat *v)) \
+    X(void, VertexAttrib4iv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttrib4s, (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w)) \
+    X(void, VertexAttrib4sv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttrib4ubv, (GLuint index, const GLubyte *v)) \
+    X(void, VertexAttrib4uiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttrib4usv, (GLuint index, const GLushort *v)) \
+    X(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)) \
+    /* 2.1 */ \
+    X(void, UniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, UniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    /* 3.0 */ \
+    X(void, ColorMaski, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a)) \
+    X(void, GetBooleani_v, (GLenum target, GLuint index, GLboolean *data)) \
+    X(void, GetIntegeri_v, (GLenum target, GLuint index, GLint *data)) \
+    X(void, Enablei, (GLenum target, GLuint index)) \
+    X(void, Disablei, (GLenum target, GLuint index)) \
+    X(GLboolean, IsEnabledi, (GLenum target, GLuint index)) \
+    X(void, BeginTransformFeedback, (GLenum primitiveMode)) \
+    X(void, EndTransformFeedback, (void)) \
+    X(void, BindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer)) \
+    X(void, TransformFeedbackVaryings, (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode)) \
+    X(void, GetTransformFeedbackVarying, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name)) \
+    X(void, ClampColor, (GLenum target, GLenum clamp)) \
+    X(void, BeginConditionalRender, (GLuint id, GLenum mode)) \
+    X(void, EndConditionalRender, (void)) \
+    X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer)) \
+    X(void, GetVertexAttribIiv, (GLuint index, GLenum pname, GLint *params)) \
+    X(void, GetVertexAttribIuiv, (GLuint index, GLenum pname, GLuint *params)) \
+    X(void, VertexAttribI1i, (GLuint index, GLint x)) \
+    X(void, VertexAttribI2i, (GLuint index, GLint x, GLint y)) \
+    X(void, VertexAttribI3i, (GLuint index, GLint x, GLint y, GLint z)) \
+    X(void, VertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w)) \
+    X(void, VertexAttribI1ui, (GLuint index, GLuint x)) \
+    X(void, VertexAttribI2ui, (GLuint index, GLuint x, GLuint y)) \
+    X(void, VertexAttribI3ui, (GLuint index, GLuint x, GLuint y, GLuint z)) \
+    X(void, VertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w)) \
+    X(void, VertexAttribI1iv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttribI2iv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttribI3iv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttribI4iv, (GLuint index, const GLint *v)) \
+    X(void, VertexAttribI1uiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttribI2uiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttribI3uiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttribI4uiv, (GLuint index, const GLuint *v)) \
+    X(void, VertexAttribI4bv, (GLuint index, const GLbyte *v)) \
+    X(void, VertexAttribI4sv, (GLuint index, const GLshort *v)) \
+    X(void, VertexAttribI4ubv, (GLuint index, const GLubyte *v)) \
+    X(void, VertexAttribI4usv, (GLuint index, const GLushort *v)) \
+    X(void, GetUniformuiv, (GLuint program, GLint location, GLuint *params)) \
+    X(void, BindFragDataLocation, (GLuint program, GLuint color, const GLchar *name)) \
+    X(GLint, GetFragDataLocation, (GLuint program, const GLchar *name)) \
+    X(void, Uniform1ui, (GLint location, GLuint v0)) \
+    X(void, Uniform2ui, (GLint location, GLuint v0, GLuint v1)) \
+    X(void, Uniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2)) \
+    X(void, Uniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)) \
+    X(void, Uniform1uiv, (GLint location, GLsizei count, const GLuint *value)) \
+    X(void, Uniform2uiv, (GLint location, GLsizei count, const GLuint *value)) \
+    X(void, Uniform3uiv, (GLint location, GLsizei count, const GLuint *value)) \
+    X(void, Uniform4uiv, (GLint location, GLsizei count, const GLuint *value)) \
+    X(void, TexParameterIiv, (GLenum target, GLenum pname, const GLint *params)) \
+    X(void, TexParameterIuiv, (GLenum target, GLenum pname, const GLuint *params)) \
+    X(void, GetTexParameterIiv, (GLenum target, GLenum pname, GLint *params)) \
+    X(void, GetTexParameterIuiv, (GLenum target, GLenum pname, GLuint *params)) \
+    X(void, ClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint *value)) \
+    X(void, ClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint *value)) \
+    X(void, ClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat *value)) \
+    X(void, ClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)) \
+    X(const GLubyte *, GetStringi, (GLenum name, GLuint index)) \
+    X(GLboolean, IsRenderbuffer, (GLuint renderbuffer)) \
+    X(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer)) \
+    X(void, DeleteRenderbuffers, (GLsizei n, const GLuint *renderbuffers)) \
+    X(void, GenRenderbuffers, (GLsizei n, GLuint *renderbuffers)) \
+    X(void, RenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, GetRenderbufferParameteriv, (GLenum target, GLenum pname, GLint *params)) \
+    X(GLboolean, IsFramebuffer, (GLuint framebuffer)) \
+    X(void, BindFramebuffer, (GLenum target, GLuint framebuffer)) \
+    X(void, DeleteFramebuffers, (GLsizei n, const GLuint *framebuffers)) \
+    X(void, GenFramebuffers, (GLsizei n, GLuint *framebuffers)) \
+    X(GLenum, CheckFramebufferStatus, (GLenum target)) \
+    X(void, FramebufferTexture1D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)) \
+    X(void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)) \
+    X(void, FramebufferTexture3D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset)) \
+    X(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)) \
+    X(void, GetFramebufferAttachmentParameteriv, (GLenum target, GLenum attachment, GLenum pname, GLint *params)) \
+    X(void, GenerateMipmap, (GLenum target)) \
+    X(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
+    X(void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, FramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)) \
+    X(void *, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    X(void, FlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length)) \
+    X(void, BindVertexArray, (GLuint array)) \
+    X(void, DeleteVertexArrays, (GLsizei n, const GLuint *arrays)) \
+    X(void, GenVertexArrays, (GLsizei n, GLuint *arrays)) \
+    X(GLboolean, IsVertexArray, (GLuint array)) \
+    /* 3.1 */ \
+    X(void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount)) \
+    X(void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount)) \
+    X(void, TexBuffer, (GLenum target, GLenum internalformat, GLuint buffer)) \
+    X(void, PrimitiveRestartIndex, (GLuint index)) \
+    X(void, CopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)) \
+    X(void, GetUniformIndices, (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices)) \
+    X(void, GetActiveUniformsiv, (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params)) \
+    X(void, GetActiveUniformName, (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName)) \
+    X(GLuint, GetUniformBlockIndex, (GLuint program, const GLchar *uniformBlockName)) \
+    X(void, GetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params)) \
+    X(void, GetActiveUniformBlockName, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName)) \
+    X(void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)) \
+    /* 3.2 */ \
+    X(void, DrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex)) \
+    X(void, DrawRangeElementsBaseVertex, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex)) \
+    X(void, DrawElementsInstancedBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex)) \
+    X(void, MultiDrawElementsBaseVertex, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex)) \
+    X(void, ProvokingVertex, (GLenum mode)) \
+    X(GLsync, FenceSync, (GLenum condition, GLbitfield flags)) \
+    X(GLboolean, IsSync, (GLsync sync)) \
+    X(void, DeleteSync, (GLsync sync)) \
+    X(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    X(void, WaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    X(void, GetInteger64v, (GLenum pname, GLint64 *data)) \
+    X(void, GetSynciv, (GLsync sync, GLenum pname, GLsizei count, GLsizei *length, GLint *values)) \
+    X(void, GetInteger64i_v, (GLenum target, GLuint index, GLint64 *data)) \
+    X(void, GetBufferParameteri64v, (GLenum target, GLenum pname, GLint64 *params)) \
+    X(void, FramebufferTexture, (GLenum target, GLenum attachment, GLuint texture, GLint level)) \
+    X(void, TexImage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations)) \
+    X(void, TexImage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations)) \
+    X(void, GetMultisamplefv, (GLenum pname, GLuint index, GLfloat *val)) \
+    X(void, SampleMaski, (GLuint maskNumber, GLbitfield mask)) \
+    /* 3.3 */ \
+    X(void, BindFragDataLocationIndexed, (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name)) \
+    X(GLint, GetFragDataIndex, (GLuint program, const GLchar *name)) \
+    X(void, GenSamplers, (GLsizei count, GLuint *samplers)) \
+    X(void, DeleteSamplers, (GLsizei count, const GLuint *samplers)) \
+    X(GLboolean, IsSampler, (GLuint sampler)) \
+    X(void, BindSampler, (GLuint unit, GLuint sampler)) \
+    X(void, SamplerParameteri, (GLuint sampler, GLenum pname, GLint param)) \
+    X(void, SamplerParameteriv, (GLuint sampler, GLenum pname, const GLint *param)) \
+    X(void, SamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param)) \
+    X(void, SamplerParameterfv, (GLuint sampler, GLenum pname, const GLfloat *param)) \
+    X(void, SamplerParameterIiv, (GLuint sampler, GLenum pname, const GLint *param)) \
+    X(void, SamplerParameterIuiv, (GLuint sampler, GLenum pname, const GLuint *param)) \
+    X(void, GetSamplerParameteriv, (GLuint sampler, GLenum pname, GLint *params)) \
+    X(void, GetSamplerParameterIiv, (GLuint sampler, GLenum pname, GLint *params)) \
+    X(void, GetSamplerParameterfv, (GLuint sampler, GLenum pname, GLfloat *params)) \
+    X(void, GetSamplerParameterIuiv, (GLuint sampler, GLenum pname, GLuint *params)) \
+    X(void, QueryCounter, (GLuint id, GLenum target)) \
+    X(void, GetQueryObjecti64v, (GLuint id, GLenum pname, GLint64 *params)) \
+    X(void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64 *params)) \
+    X(void, VertexAttribDivisor, (GLuint index, GLuint divisor)) \
+    X(void, VertexAttribP1ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value)) \
+    X(void, VertexAttribP1uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value)) \
+    X(void, VertexAttribP2ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value)) \
+    X(void, VertexAttribP2uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value)) \
+    X(void, VertexAttribP3ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value)) \
+    X(void, VertexAttribP3uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value)) \
+    X(void, VertexAttribP4ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value)) \
+    X(void, VertexAttribP4uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value)) \
+    /* 4.0 */ \
+    X(void, MinSampleShading, (GLfloat value)) \
+    X(void, BlendEquationi, (GLuint buf, GLenum mode)) \
+    X(void, BlendEquationSeparatei, (GLuint buf, GLenum modeRGB, GLenum modeAlpha)) \
+    X(void, BlendFunci, (GLuint buf, GLenum src, GLenum dst)) \
+    X(void, BlendFuncSeparatei, (GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)) \
+    X(void, DrawArraysIndirect, (GLenum mode, const void *indirect)) \
+    X(void, DrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect)) \
+    X(void, Uniform1d, (GLint location, GLdouble x)) \
+    X(void, Uniform2d, (GLint location, GLdouble x, GLdouble y)) \
+    X(void, Uniform3d, (GLint location, GLdouble x, GLdouble y, GLdouble z)) \
+    X(void, Uniform4d, (GLint location, GLdouble x, GLdouble y, GLdouble z, GLdouble w)) \
+    X(void, Uniform1dv, (GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, Uniform2dv, (GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, Uniform3dv, (GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, Uniform4dv, (GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, UniformMatrix2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix2x3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix2x4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix3x2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix3x4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix4x2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, UniformMatrix4x3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, GetUniformdv, (GLuint program, GLint location, GLdouble *params)) \
+    X(GLint, GetSubroutineUniformLocation, (GLuint program, GLenum shadertype, const GLchar *name)) \
+    X(GLuint, GetSubroutineIndex, (GLuint program, GLenum shadertype, const GLchar *name)) \
+    X(void, GetActiveSubroutineUniformiv, (GLuint program, GLenum shadertype, GLuint index, GLenum pname, GLint *values)) \
+    X(void, GetActiveSubroutineUniformName, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name)) \
+    X(void, GetActiveSubroutineName, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name)) \
+    X(void, UniformSubroutinesuiv, (GLenum shadertype, GLsizei count, const GLuint *indices)) \
+    X(void, GetUniformSubroutineuiv, (GLenum shadertype, GLint location, GLuint *params)) \
+    X(void, GetProgramStageiv, (GLuint program, GLenum shadertype, GLenum pname, GLint *values)) \
+    X(void, PatchParameteri, (GLenum pname, GLint value)) \
+    X(void, PatchParameterfv, (GLenum pname, const GLfloat *values)) \
+    X(void, BindTransformFeedback, (GLenum target, GLuint id)) \
+    X(void, DeleteTransformFeedbacks, (GLsizei n, const GLuint *ids)) \
+    X(void, GenTransformFeedbacks, (GLsizei n, GLuint *ids)) \
+    X(GLboolean, IsTransformFeedback, (GLuint id)) \
+    X(void, PauseTransformFeedback, (void)) \
+    X(void, ResumeTransformFeedback, (void)) \
+    X(void, DrawTransformFeedback, (GLenum mode, GLuint id)) \
+    X(void, DrawTransformFeedbackStream, (GLenum mode, GLuint id, GLuint stream)) \
+    X(void, BeginQueryIndexed, (GLenum target, GLuint index, GLuint id)) \
+    X(void, EndQueryIndexed, (GLenum target, GLuint index)) \
+    X(void, GetQueryIndexediv, (GLenum target, GLuint index, GLenum pname, GLint *params)) \
+    /* 4.1 */ \
+    X(void, ReleaseShaderCompiler, (void)) \
+    X(void, ShaderBinary, (GLsizei count, const GLuint *shaders, GLenum binaryFormat, const void *binary, GLsizei length)) \
+    X(void, GetShaderPrecisionFormat, (GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision)) \
+    X(void, DepthRangef, (GLfloat n, GLfloat f)) \
+    X(void, ClearDepthf, (GLfloat d)) \
+    X(void, GetProgramBinary, (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary)) \
+    X(void, ProgramBinary, (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length)) \
+    X(void, ProgramParameteri, (GLuint program, GLenum pname, GLint value)) \
+    X(void, UseProgramStages, (GLuint pipeline, GLbitfield stages, GLuint program)) \
+    X(void, ActiveShaderProgram, (GLuint pipeline, GLuint program)) \
+    X(GLuint, CreateShaderProgramv, (GLenum type, GLsizei count, const GLchar *const*strings)) \
+    X(void, BindProgramPipeline, (GLuint pipeline)) \
+    X(void, DeleteProgramPipelines, (GLsizei n, const GLuint *pipelines)) \
+    X(void, GenProgramPipelines, (GLsizei n, GLuint *pipelines)) \
+    X(GLboolean, IsProgramPipeline, (GLuint pipeline)) \
+    X(void, GetProgramPipelineiv, (GLuint pipeline, GLenum pname, GLint *params)) \
+    X(void, ProgramUniform1i, (GLuint program, GLint location, GLint v0)) \
+    X(void, ProgramUniform1iv, (GLuint program, GLint location, GLsizei count, const GLint *value)) \
+    X(void, ProgramUniform1f, (GLuint program, GLint location, GLfloat v0)) \
+    X(void, ProgramUniform1fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, ProgramUniform1d, (GLuint program, GLint location, GLdouble v0)) \
+    X(void, ProgramUniform1dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, ProgramUniform1ui, (GLuint program, GLint location, GLuint v0)) \
+    X(void, ProgramUniform1uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value)) \
+    X(void, ProgramUniform2i, (GLuint program, GLint location, GLint v0, GLint v1)) \
+    X(void, ProgramUniform2iv, (GLuint program, GLint location, GLsizei count, const GLint *value)) \
+    X(void, ProgramUniform2f, (GLuint program, GLint location, GLfloat v0, GLfloat v1)) \
+    X(void, ProgramUniform2fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, ProgramUniform2d, (GLuint program, GLint location, GLdouble v0, GLdouble v1)) \
+    X(void, ProgramUniform2dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, ProgramUniform2ui, (GLuint program, GLint location, GLuint v0, GLuint v1)) \
+    X(void, ProgramUniform2uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value)) \
+    X(void, ProgramUniform3i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2)) \
+    X(void, ProgramUniform3iv, (GLuint program, GLint location, GLsizei count, const GLint *value)) \
+    X(void, ProgramUniform3f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2)) \
+    X(void, ProgramUniform3fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, ProgramUniform3d, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2)) \
+    X(void, ProgramUniform3dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, ProgramUniform3ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2)) \
+    X(void, ProgramUniform3uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value)) \
+    X(void, ProgramUniform4i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2, GLint v3)) \
+    X(void, ProgramUniform4iv, (GLuint program, GLint location, GLsizei count, const GLint *value)) \
+    X(void, ProgramUniform4f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)) \
+    X(void, ProgramUniform4fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value)) \
+    X(void, ProgramUniform4d, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2, GLdouble v3)) \
+    X(void, ProgramUniform4dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value)) \
+    X(void, ProgramUniform4ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3)) \
+    X(void, ProgramUniform4uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value)) \
+    X(void, ProgramUniformMatrix2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix2x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix3x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix2x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix4x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix3x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix4x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(void, ProgramUniformMatrix2x3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix3x2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix2x4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix4x2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix3x4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ProgramUniformMatrix4x3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value)) \
+    X(void, ValidateProgramPipeline, (GLuint pipeline)) \
+    X(void, GetProgramPipelineInfoLog, (GLuint pipeline, GLsizei bufSize, GLsizei *length, GLchar *infoLog)) \
+    X(void, VertexAttribL1d, (GLuint index, GLdouble x)) \
+    X(void, VertexAttribL2d, (GLuint index, GLdouble x, GLdouble y)) \
+    X(void, VertexAttribL3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z)) \
+    X(void, VertexAttribL4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w)) \
+    X(void, VertexAttribL1dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttribL2dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttribL3dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttribL4dv, (GLuint index, const GLdouble *v)) \
+    X(void, VertexAttribLPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer)) \
+    X(void, GetVertexAttribLdv, (GLuint index, GLenum pname, GLdouble *params)) \
+    X(void, ViewportArrayv, (GLuint first, GLsizei count, const GLfloat *v)) \
+    X(void, ViewportIndexedf, (GLuint index, GLfloat x, GLfloat y, GLfloat w, GLfloat h)) \
+    X(void, ViewportIndexedfv, (GLuint index, const GLfloat *v)) \
+    X(void, ScissorArrayv, (GLuint first, GLsizei count, const GLint *v)) \
+    X(void, ScissorIndexed, (GLuint index, GLint left, GLint bottom, GLsizei width, GLsizei height)) \
+    X(void, ScissorIndexedv, (GLuint index, const GLint *v)) \
+    X(void, DepthRangeArrayv, (GLuint first, GLsizei count, const GLdouble *v)) \
+    X(void, DepthRangeIndexed, (GLuint index, GLdouble n, GLdouble f)) \
+    X(void, GetFloati_v, (GLenum target, GLuint index, GLfloat *data)) \
+    X(void, GetDoublei_v, (GLenum target, GLuint index, GLdouble *data)) \
+    /* 4.2 */ \
+    X(void, DrawArraysInstancedBaseInstance, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount, GLuint baseinstance)) \
+    X(void, DrawElementsInstancedBaseInstance, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLuint baseinstance)) \
+    X(void, DrawElementsInstancedBaseVertexBaseInstance, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance)) \
+    X(void, GetInternalformativ, (GLenum target, GLenum internalformat, GLenum pname, GLsizei count, GLint *params)) \
+    X(void, GetActiveAtomicCounterBufferiv, (GLuint program, GLuint bufferIndex, GLenum pname, GLint *params)) \
+    X(void, BindImageTexture, (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)) \
+    X(void, MemoryBarrier, (GLbitfield barriers)) \
+    X(void, TexStorage1D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width)) \
+    X(void, TexStorage2D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, TexStorage3D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)) \
+    X(void, DrawTransformFeedbackInstanced, (GLenum mode, GLuint id, GLsizei instancecount)) \
+    X(void, DrawTransformFeedbackStreamInstanced, (GLenum mode, GLuint id, GLuint stream, GLsizei instancecount)) \
+    /* 4.3 */ \
+    X(void, ClearBufferData, (GLenum target, GLenum internalformat, GLenum format, GLenum type, const void *data)) \
+    X(void, ClearBufferSubData, (GLenum target, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data)) \
+    X(void, DispatchCompute, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)) \
+    X(void, DispatchComputeIndirect, (GLintptr indirect)) \
+    X(void, CopyImageSubData, (GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth)) \
+    X(void, FramebufferParameteri, (GLenum target, GLenum pname, GLint param)) \
+    X(void, GetFramebufferParameteriv, (GLenum target, GLenum pname, GLint *params)) \
+    X(void, GetInternalformati64v, (GLenum target, GLenum internalformat, GLenum pname, GLsizei count, GLint64 *params)) \
+    X(void, InvalidateTexSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth)) \
+    X(void, InvalidateTexImage, (GLuint texture, GLint level)) \
+    X(void, InvalidateBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr length)) \
+    X(void, InvalidateBufferData, (GLuint buffer)) \
+    X(void, InvalidateFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum *attachments)) \
+    X(void, InvalidateSubFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, MultiDrawArraysIndirect, (GLenum mode, const void *indirect, GLsizei drawcount, GLsizei stride)) \
+    X(void, MultiDrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride)) \
+    X(void, GetProgramInterfaceiv, (GLuint program, GLenum programInterface, GLenum pname, GLint *params)) \
+    X(GLuint, GetProgramResourceIndex, (GLuint program, GLenum programInterface, const GLchar *name)) \
+    X(void, GetProgramResourceName, (GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name)) \
+    X(void, GetProgramResourceiv, (GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum *props, GLsizei count, GLsizei *length, GLint *params)) \
+    X(GLint, GetProgramResourceLocation, (GLuint program, GLenum programInterface, const GLchar *name)) \
+    X(GLint, GetProgramResourceLocationIndex, (GLuint program, GLenum programInterface, const GLchar *name)) \
+    X(void, ShaderStorageBlockBinding, (GLuint program, GLuint storageBlockIndex, GLuint storageBlockBinding)) \
+    X(void, TexBufferRange, (GLenum target, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    X(void, TexStorage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations)) \
+    X(void, TexStorage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations)) \
+    X(void, TextureView, (GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers)) \
+    X(void, BindVertexBuffer, (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride)) \
+    X(void, VertexAttribFormat, (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset)) \
+    X(void, VertexAttribIFormat, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset)) \
+    X(void, VertexAttribLFormat, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset)) \
+    X(void, VertexAttribBinding, (GLuint attribindex, GLuint bindingindex)) \
+    X(void, VertexBindingDivisor, (GLuint bindingindex, GLuint divisor)) \
+    X(void, DebugMessageControl, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled)) \
+    X(void, DebugMessageInsert, (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf)) \
+    X(void, DebugMessageCallback, (GLDEBUGPROC callback, const void *userParam)) \
+    X(GLuint, GetDebugMessageLog, (GLuint count, GLsizei bufSize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog)) \
+    X(void, PushDebugGroup, (GLenum source, GLuint id, GLsizei length, const GLchar *message)) \
+    X(void, PopDebugGroup, (void)) \
+    X(void, ObjectLabel, (GLenum identifier, GLuint name, GLsizei length, const GLchar *label)) \
+    X(void, GetObjectLabel, (GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label)) \
+    X(void, ObjectPtrLabel, (const void *ptr, GLsizei length, const GLchar *label)) \
+    X(void, GetObjectPtrLabel, (const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label)) \
+    /* 4.4 */ \
+    X(void, BufferStorage, (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)) \
+    X(void, ClearTexImage, (GLuint texture, GLint level, GLenum format, GLenum type, const void *data)) \
+    X(void, ClearTexSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *data)) \
+    X(void, BindBuffersBase, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers)) \
+    X(void, BindBuffersRange, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizeiptr *sizes)) \
+    X(void, BindTextures, (GLuint first, GLsizei count, const GLuint *textures)) \
+    X(void, BindSamplers, (GLuint first, GLsizei count, const GLuint *samplers)) \
+    X(void, BindImageTextures, (GLuint first, GLsizei count, const GLuint *textures)) \
+    X(void, BindVertexBuffers, (GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides)) \
+    /* 4.5 */ \
+    X(void, ClipControl, (GLenum origin, GLenum depth)) \
+    X(void, CreateTransformFeedbacks, (GLsizei n, GLuint *ids)) \
+    X(void, TransformFeedbackBufferBase, (GLuint xfb, GLuint index, GLuint buffer)) \
+    X(void, TransformFeedbackBufferRange, (GLuint xfb, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    X(void, GetTransformFeedbackiv, (GLuint xfb, GLenum pname, GLint *param)) \
+    X(void, GetTransformFeedbacki_v, (GLuint xfb, GLenum pname, GLuint index, GLint *param)) \
+    X(void, GetTransformFeedbacki64_v, (GLuint xfb, GLenum pname, GLuint index, GLint64 *param)) \
+    X(void, CreateBuffers, (GLsizei n, GLuint *buffers)) \
+    X(void, NamedBufferStorage, (GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags)) \
+    X(void, NamedBufferData, (GLuint buffer, GLsizeiptr size, const void *data, GLenum usage)) \
+    X(void, NamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data)) \
+    X(void, CopyNamedBufferSubData, (GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)) \
+    X(void, ClearNamedBufferData, (GLuint buffer, GLenum internalformat, GLenum format, GLenum type, const void *data)) \
+    X(void, ClearNamedBufferSubData, (GLuint buffer, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data)) \
+    X(void *, MapNamedBuffer, (GLuint buffer, GLenum access)) \
+    X(void *, MapNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    X(GLboolean, UnmapNamedBuffer, (GLuint buffer)) \
+    X(void, FlushMappedNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length)) \
+    X(void, GetNamedBufferParameteriv, (GLuint buffer, GLenum pname, GLint *params)) \
+    X(void, GetNamedBufferParameteri64v, (GLuint buffer, GLenum pname, GLint64 *params)) \
+    X(void, GetNamedBufferPointerv, (GLuint buffer, GLenum pname, void **params)) \
+    X(void, GetNamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, void *data)) \
+    X(void, CreateFramebuffers, (GLsizei n, GLuint *framebuffers)) \
+    X(void, NamedFramebufferRenderbuffer, (GLuint framebuffer, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)) \
+    X(void, NamedFramebufferParameteri, (GLuint framebuffer, GLenum pname, GLint param)) \
+    X(void, NamedFramebufferTexture, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level)) \
+    X(void, NamedFramebufferTextureLayer, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level, GLint layer)) \
+    X(void, NamedFramebufferDrawBuffer, (GLuint framebuffer, GLenum buf)) \
+    X(void, NamedFramebufferDrawBuffers, (GLuint framebuffer, GLsizei n, const GLenum *bufs)) \
+    X(void, NamedFramebufferReadBuffer, (GLuint framebuffer, GLenum src)) \
+    X(void, InvalidateNamedFramebufferData, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments)) \
+    X(void, InvalidateNamedFramebufferSubData, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, ClearNamedFramebufferiv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLint *value)) \
+    X(void, ClearNamedFramebufferuiv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLuint *value)) \
+    X(void, ClearNamedFramebufferfv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLfloat *value)) \
+    X(void, ClearNamedFramebufferfi, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)) \
+    X(void, BlitNamedFramebuffer, (GLuint readFramebuffer, GLuint drawFramebuffer, GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
+    X(GLenum, CheckNamedFramebufferStatus, (GLuint framebuffer, GLenum target)) \
+    X(void, GetNamedFramebufferParameteriv, (GLuint framebuffer, GLenum pname, GLint *param)) \
+    X(void, GetNamedFramebufferAttachmentParameteriv, (GLuint framebuffer, GLenum attachment, GLenum pname, GLint *params)) \
+    X(void, CreateRenderbuffers, (GLsizei n, GLuint *renderbuffers)) \
+    X(void, NamedRenderbufferStorage, (GLuint renderbuffer, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, NamedRenderbufferStorageMultisample, (GLuint renderbuffer, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, GetNamedRenderbufferParameteriv, (GLuint renderbuffer, GLenum pname, GLint *params)) \
+    X(void, CreateTextures, (GLenum target, GLsizei n, GLuint *textures)) \
+    X(void, TextureBuffer, (GLuint texture, GLenum internalformat, GLuint buffer)) \
+    X(void, TextureBufferRange, (GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    X(void, TextureStorage1D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width)) \
+    X(void, TextureStorage2D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, TextureStorage3D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)) \
+    X(void, TextureStorage2DMultisample, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations)) \
+    X(void, TextureStorage3DMultisample, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations)) \
+    X(void, TextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels)) \
+    X(void, CompressedTextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, CompressedTextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data)) \
+    X(void, CopyTextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width)) \
+    X(void, CopyTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, CopyTextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, TextureParameterf, (GLuint texture, GLenum pname, GLfloat param)) \
+    X(void, TextureParameterfv, (GLuint texture, GLenum pname, const GLfloat *param)) \
+    X(void, TextureParameteri, (GLuint texture, GLenum pname, GLint param)) \
+    X(void, TextureParameterIiv, (GLuint texture, GLenum pname, const GLint *params)) \
+    X(void, TextureParameterIuiv, (GLuint texture, GLenum pname, const GLuint *params)) \
+    X(void, TextureParameteriv, (GLuint texture, GLenum pname, const GLint *param)) \
+    X(void, GenerateTextureMipmap, (GLuint texture)) \
+    X(void, BindTextureUnit, (GLuint unit, GLuint texture)) \
+    X(void, GetTextureImage, (GLuint texture, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels)) \
+    X(void, GetCompressedTextureImage, (GLuint texture, GLint level, GLsizei bufSize, void *pixels)) \
+    X(void, GetTextureLevelParameterfv, (GLuint texture, GLint level, GLenum pname, GLfloat *params)) \
+    X(void, GetTextureLevelParameteriv, (GLuint texture, GLint level, GLenum pname, GLint *params)) \
+    X(void, GetTextureParameterfv, (GLuint texture, GLenum pname, GLfloat *params)) \
+    X(void, GetTextureParameterIiv, (GLuint texture, GLenum pname, GLint *params)) \
+    X(void, GetTextureParameterIuiv, (GLuint texture, GLenum pname, GLuint *params)) \
+    X(void, GetTextureParameteriv, (GLuint texture, GLenum pname, GLint *params)) \
+    X(void, CreateVertexArrays, (GLsizei n, GLuint *arrays)) \
+    X(void, DisableVertexArrayAttrib, (GLuint vaobj, GLuint index)) \
+    X(void, EnableVertexArrayAttrib, (GLuint vaobj, GLuint index)) \
+    X(void, VertexArrayElementBuffer, (GLuint vaobj, GLuint buffer)) \
+    X(void, VertexArrayVertexBuffer, (GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride)) \
+    X(void, VertexArrayVertexBuffers, (GLuint vaobj, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides)) \
+    X(void, VertexArrayAttribBinding, (GLuint vaobj, GLuint attribindex, GLuint bindingindex)) \
+    X(void, VertexArrayAttribFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset)) \
+    X(void, VertexArrayAttribIFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset)) \
+    X(void, VertexArrayAttribLFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset)) \
+    X(void, VertexArrayBindingDivisor, (GLuint vaobj, GLuint bindingindex, GLuint divisor)) \
+    X(void, GetVertexArrayiv, (GLuint vaobj, GLenum pname, GLint *param)) \
+    X(void, GetVertexArrayIndexediv, (GLuint vaobj, GLuint index, GLenum pname, GLint *param)) \
+    X(void, GetVertexArrayIndexed64iv, (GLuint vaobj, GLuint index, GLenum pname, GLint64 *param)) \
+    X(void, CreateSamplers, (GLsizei n, GLuint *samplers)) \
+    X(void, CreateProgramPipelines, (GLsizei n, GLuint *pipelines)) \
+    X(void, CreateQueries, (GLenum target, GLsizei n, GLuint *ids)) \
+    X(void, GetQueryBufferObjecti64v, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset)) \
+    X(void, GetQueryBufferObjectiv, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset)) \
+    X(void, GetQueryBufferObjectui64v, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset)) \
+    X(void, GetQueryBufferObjectuiv, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset)) \
+    X(void, MemoryBarrierByRegion, (GLbitfield barriers)) \
+    X(void, GetTextureSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, GLsizei bufSize, void *pixels)) \
+    X(void, GetCompressedTextureSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLsizei bufSize, void *pixels)) \
+    X(GLenum, GetGraphicsResetStatus, (void)) \
+    X(void, GetnCompressedTexImage, (GLenum target, GLint lod, GLsizei bufSize, void *pixels)) \
+    X(void, GetnTexImage, (GLenum target, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels)) \
+    X(void, GetnUniformdv, (GLuint program, GLint location, GLsizei bufSize, GLdouble *params)) \
+    X(void, GetnUniformfv, (GLuint program, GLint location, GLsizei bufSize, GLfloat *params)) \
+    X(void, GetnUniformiv, (GLuint program, GLint location, GLsizei bufSize, GLint *params)) \
+    X(void, GetnUniformuiv, (GLuint program, GLint location, GLsizei bufSize, GLuint *params)) \
+    X(void, ReadnPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLsizei bufSize, void *data)) \
+    X(void, TextureBarrier, (void)) \
+    /* 4.6 */ \
+    X(void, SpecializeShader, (GLuint shader, const GLchar *pEntryPoint, GLuint numSpecializationConstants, const GLuint *pConstantIndex, const GLuint *pConstantValue)) \
+    X(void, MultiDrawArraysIndirectCount, (GLenum mode, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride)) \
+    X(void, MultiDrawElementsIndirectCount, (GLenum mode, GLenum type, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride)) \
+    X(void, PolygonOffsetClamp, (GLfloat factor, GLfloat units, GLfloat clamp))
+
+enum {
+#define GLC_FUNCTION_ENUM(type, name, params) GLC_FUNCTION_##name,
+    GLC_GL_FUNCTIONS(GLC_FUNCTION_ENUM)
+#undef GLC_FUNCTION_ENUM
+    GLC_FUNCTION_COUNT
+};
+
+// Call through the named members, e.g. gl->Clear(GL_COLOR_BUFFER_BIT)
+typedef union GLCFunctions {
+    struct {
+#define GLC_FUNCTION_MEMBER(type, name, params) type (APIENTRYP name) params;
+        GLC_GL_FUNCTIONS(GLC_FUNCTION_MEMBER)
+#undef GLC_FUNCTION_MEMBER
+    };
+    GLCProc procs[GLC_FUNCTION_COUNT];
+} GLCFunctions;
+
+// One table per backend: GLX and EGL addresses don't depend on the context,
+// so every context of the backend uses it. The first call looks up every
+// entry point by name through the driver's loader. Entry points beyond the
+// version of the current context must not be called.
+GLCDEF const GLCFunctions *glcGetFunctions(GLCBackend *backend);
+#endif
+
+typedef struct GLCProfiler GLCProfiler;
+
+#ifdef GLC_USE_PROFILER
+typedef struct GLCProfilerZone {
+    // Pointer passed to glcProfilerBeginZone, it has to outlive the readback
+    const char *name;
+    // 0 for the frame itself
+    int depth;
+    // Index of the enclosing zone, -1 for the frame
+    int parent;
+    // CPU clock, GPU timestamps are converted to the same clock
+    unsigned long long cpu_begin_ns, cpu_end_ns;
+    unsigned long long gpu_begin_ns, gpu_end_ns;
+} GLCProfilerZone;
+
+typedef struct GLCProfilerFrame {
+    unsigned long long index;
+    unsigned long long cpu_ns, gpu_ns;
+    // zones[0] is the whole frame, children follow in begin order
+    const GLCProfilerZone *zones;
+    int zone_count;
+    // Zones that didn't fit in max_zones and were left out
+    int dropped_zones;
+    // Frames whose queries weren't ready when their slot was reused
+    unsigned long long dropped_frames;
+} GLCProfilerFrame;
+
+// GPU timestamps through GL_ARB_timer_query (core since 3.3), the context has
+// to be current whenever the profiler is used. Results are read back
+// GLC_PROFILER_LATENCY frames later without waiting on the GPU.
+GLCDEF GLCProfiler *glcCreateProfiler(GLCBackend *backend, GLCContext *context, int max_zones);
+GLCDEF void glcDestroyProfiler(GLCProfiler *profiler);
+GLCDEF void glcProfilerBeginFrame(GLCProfiler *profiler);
+GLCDEF void glcProfilerEndFrame(GLCProfiler *profiler);
+// Zones nest and must be closed in reverse order within a frame
+GLCDEF void glcProfilerBeginZone(GLCProfiler *profiler, const char *name);
+GLCDEF void glcProfilerEndZone(GLCProfiler *profiler);
+// Latest frame whose results are available, valid until the next
+// glcProfilerEndFrame. Returns 0 if no frame has been read back yet.
+GLCDEF int glcProfilerGetFrame(GLCProfiler *profiler, GLCProfilerFrame *frame);
+
+#define GLC_PROFILER_BEGIN_FRAME(profiler) glcProfilerBeginFrame(profiler)
+#define GLC_PROFILER_END_FRAME(profiler) glcProfilerEndFrame(profiler)
+#define GLC_PROFILER_BEGIN_ZONE(profiler, name) glcProfilerBeginZone((profiler), (name))
+#define GLC_PROFILER_END_ZONE(profiler) glcProfilerEndZone(profiler)
+#else
+// Instrumentation compiles to nothing without GLC_USE_PROFILER
+#define GLC_PROFILER_BEGIN_FRAME(profiler) ((void)0)
+#define GLC_PROFILER_END_FRAME(profiler) ((void)0)
+#define GLC_PROFILER_BEGIN_ZONE(profiler, name) ((void)0)
+#define GLC_PROFILER_END_ZONE(profiler) ((void)0)
+#endif
+
+typedef struct GLCPresenter GLCPresenter;
+
+#ifdef GLC_USE_PRESENTER
+// Swaps the window on a present thread so vblank waits don't block rendering.
+// The presenter takes window_context over and binds it on its own thread, set
+// its swap interval beforehand. Rendering happens on a context created from
+// config that shares objects with window_context, it is made current on the
+// calling thread. Frames go into width x height framebuffer objects that the
+// present thread blits to the window, at most max_frames_in_flight of them
+// wait for presentation. The window framebuffer config must not be
+// multisampled.
+// Every presented frame costs a full width x height blit on the present thread
+// on top of the swap, so the presenter only pays off when vblank waits dominate:
+// on llvmpipe at 640x480 a frame took 1.79 ms through the presenter against
+// 0.44 ms swapping on the render thread.
+GLCDEF GLCPresenter *glcCreatePresenter(GLCBackend *backend, GLCContext *window_context,
+        const GLCContextConfig *config, int width, int height, int max_frames_in_flight);
+// Stops the present thread, frames still queued are dropped. Call it from the
+// render thread, window_context can be used again afterwards.
+GLCDEF void glcDestroyPresenter(GLCPresenter *presenter);
+GLCDEF GLCContext *glcPresenterGetContext(GLCPresenter *presenter);
+// Size of the frames begun from now on
+GLCDEF void glcPresenterResize(GLCPresenter *presenter, int width, int height);
+// Binds the framebuffer of the next frame, blocking while max_frames_in_flight
+// frames are queued. Returns the framebuffer name or 0 once the present
+// thread has stopped.
+GLCDEF unsigned int glcPresenterBeginFrame(GLCPresenter *presenter);
+// Fences the frame and queues it for the present thread without waiting
+GLCDEF void glcPresenterEndFrame(GLCPresenter *presenter);
+#endif
+
+typedef struct GLCCapture GLCCapture;
+
+#ifdef GLC_USE_CAPTURE
+typedef struct GLCCaptureFrame {
+    unsigned long long index;
+    int width, height;
+    // Tightly packed RGBA8 rows, bottom row first. Only valid during the callback.
+    const unsigned char *pixels;
+} GLCCaptureFrame;
+
+// Runs on the sink thread when the capture has one, see glcCreateCapture
+
+typedef void (*GLCCaptureCallback)(const GLCCaptureFrame *frame, void *user_data);
+
+typedef struct GLCCaptureStats {
+    unsigned long long captured;
+    unsigned long long delivered;
+    // Frames whose readback wasn't finished when their buffer was needed
+    // again, the render thread waited for them
+    unsigned long long stalls;
+    // Frames whose buffer the sink thread was still reading when it was
+    // needed again, the render thread waited for the sinks
+    unsigned long long sink_stalls;
+    // Frames glcCaptureFrame had to hand to the sinks itself because
+    // glcCaptureDeliver didn't run before their buffer was needed again
+    unsigned long long overruns;
+    // Frames written to the file sink, later frames are left out once it is full
+    unsigned long long file_frames;
+    // Time spent in glcCaptureFrame on the render thread
+    unsigned long long last_cpu_ns, total_cpu_ns;
+    // Time spent in glcCaptureDeliver
+    unsigned long long last_deliver_ns, total_deliver_ns;
+    // Time the callback and the file sink took, on the sink thread when there is one
+    unsigned long long total_sink_ns;
+} GLCCaptureStats;
+
+// Reads width x height pixels from the bottom left of the read framebuffer
+// into a ring of buffer_count pixel pack buffers. With OpenGL 4.4 or
+// GL_ARB_buffer_storage the buffers stay mapped and a sink thread runs the
+// callback and the file sink, so they cost the render thread nothing.
+// Otherwise they run in glcCaptureDeliver on the calling thread. The context
+// has to be current whenever the capture is used.
+GLCDEF GLCCapture *glcCreateCapture(GLCBackend *backend, GLCContext *context, int width, int height, int buffer_count);
+// Delivers the frames still in flight, waiting for them and the sinks
+GLCDEF void glcDestroyCapture(GLCCapture *capture);
+GLCDEF void glcCaptureSetCallback(GLCCapture *capture, GLCCaptureCallback callback, void *user_data);
+// Streams frames back to back into a file mapped for max_frames frames of
+// width * height * 4 bytes. Returns 0 if the file couldn't be mapped.
+GLCDEF int glcCaptureSetFile(GLCCapture *capture, const char *path, int max_frames);
+// Queue the readback of the frame, call it before glcSwapBuffer. When every
+// buffer still holds an undelivered frame the oldest one is delivered first.
+GLCDEF void glcCaptureFrame(GLCCapture *capture);
+// Hands the frames whose readback finished to the sinks, oldest first, without
+// waiting on the GPU or, with a sink thread, on the sinks. Call it after
+// glcSwapBuffer. Returns the number of frames handed over.
+GLCDEF int glcCaptureDeliver(GLCCapture *capture);
+GLCDEF void glcGetCaptureStats(GLCCapture *capture, GLCCaptureStats *stats);
+#endif
 
 #endif // GLC_H_
 
 #ifdef GLC_IMPLEMENTATION
 
-#ifdef GLC_DISPLAY_X11
+#include <stdio.h> // fopen
+#ifndef GLC_DISPLAY_WIN32
+#include <time.h> // clock_gettime
+#endif
+
+#ifndef GLC_PROFILER_LATENCY
+#define GLC_PROFILER_LATENCY 4
+#endif
+
+#if (defined(GLC_USE_PRESENTER) || defined(GLC_USE_CAPTURE)) && !defined(GLC_DISPLAY_WIN32)
+#include <pthread.h>
+#endif
+
+#if defined(GLC_USE_CAPTURE) && !defined(GLC_DISPLAY_WIN32)
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap
+#include <unistd.h> // ftruncate
+#endif
+
+#if defined(_MSC_VER)
+#define GLC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) && (!defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L)
+#define GLC_THREAD_LOCAL __thread
+#else
+#define GLC_THREAD_LOCAL _Thread_local
+#endif
+
+#ifdef GLC_BACKEND_GLX
 #include <GL/glx.h>
 #include <X11/Xlib.h>
 #endif
 
+#ifdef GLC_BACKEND_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#ifdef GLC_DISPLAY_X11
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#endif
+#endif
+
 struct GLCBackend {
 #ifdef GLC_DISPLAY_WIN32
     struct {
@@ -139,11 +1195,14 @@ struct GLCBackend {
         Display *display;
         XVisualInfo *visual_info;
     } x11;
+#endif
+#ifdef GLC_BACKEND_GLX
     struct {
         int event_base, error_base;
         int major, minor;
         struct {
             Bool EXT_swap_control;
+            Bool EXT_swap_control_tear;
             Bool SGI_swap_control;
             Bool MESA_swap_control;
             Bool ARB_multisample;
@@ -155,16 +1214,55 @@ struct GLCBackend {
             Bool EXT_create_context_es2_profile;
             Bool ARB_create_context_no_error;
             Bool ARB_context_flush_control;
+            Bool OML_sync_control;
         } extensions;
         struct {
             PFNGLXSWAPINTERVALEXTPROC SwapIntervalEXT;
             PFNGLXSWAPINTERVALSGIPROC SwapIntervalSGI;
             PFNGLXSWAPINTERVALMESAPROC SwapIntervalMESA;
+            PFNGLXGETSWAPINTERVALMESAPROC GetSwapIntervalMESA;
             PFNGLXCREATECONTEXTATTRIBSARBPROC CreateContextAttribsARB;
+            PFNGLXGETSYNCVALUESOMLPROC GetSyncValuesOML;
+            PFNGLXSWAPBUFFERSMSCOMLPROC SwapBuffersMscOML;
+            PFNGLXWAITFORSBCOMLPROC WaitForSbcOML;
         } api;
         GLXFBConfig fbconfig;
     } glx;
 #endif
+#ifdef GLC_BACKEND_EGL
+    struct {
+        EGLDisplay display;
+        EGLConfig config;
+        EGLint major, minor;
+        struct {
+            EGLBoolean KHR_create_context;
+            EGLBoolean KHR_create_context_no_error;
+            EGLBoolean KHR_context_flush_control;
+            EGLBoolean KHR_surfaceless_context;
+            EGLBoolean KHR_gl_colorspace;
+            EGLBoolean KHR_swap_buffers_with_damage;
+            EGLBoolean EXT_swap_buffers_with_damage;
+        } extensions;
+        struct {
+            PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC CreatePlatformWindowSurfaceEXT;
+            // KHR or EXT variant, both share the signature
+            PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC SwapBuffersWithDamage;
+        } api;
+        // Window surfaces are created with an sRGB color space when requested
+        char use_srgb;
+    } egl;
+#endif
+    struct {
+        PFNGLFENCESYNCPROC FenceSync;
+        PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+        PFNGLWAITSYNCPROC WaitSync;
+        PFNGLDELETESYNCPROC DeleteSync;
+    } gl;
+#ifdef GLC_USE_FUNCTIONS
+    GLCFunctions *functions;
+    // Open addressing table from name hash to function index + 1, 0 marks an empty slot
+    unsigned short *function_index;
+#endif
 };
 
 struct GLCContext {
@@ -179,11 +1277,44 @@ struct GLCContext {
     struct {
         Window window;
     } x11;
+#endif
+#ifdef GLC_BACKEND_GLX
     struct {
         GLXContext context;
         GLXWindow window;
+        // Only offscreen contexts have a pbuffer, both are None when surfaceless
+        GLXPbuffer pbuffer;
+        // Last interval set through GLC, used when the driver can't be queried
+        int swap_interval;
     } glx;
 #endif
+#ifdef GLC_BACKEND_EGL
+    struct {
+        EGLContext context;
+        // EGL_NO_SURFACE when surfaceless
+        EGLSurface surface;
+        char has_window;
+        // Last interval set through GLC, EGL can't query it
+        int swap_interval;
+    } egl;
+#endif
+    struct {
+        long long swaps;
+        // CPU clock estimate used without present feedback
+        long long last_swap_us;
+        long long average_period_us;
+        long long estimated_missed;
+        long long missed_vblanks;
+        // Last completion reported by the driver, -1 before the first query
+        long long last_msc, last_sbc;
+    } timing;
+    struct {
+        // Interval to restore once the context paces a frame again
+        int interval;
+        char is_unpaced;
+        // The driver can't disable vsync, don't retry every frame
+        char is_unsupported;
+    } group;
 };
 
 #ifdef GLC_DISPLAY_WIN32
@@ -191,14 +1322,22 @@ struct GLCContext {
 static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *config);
 static void glcDeinitBackend_Platform(GLCBackend *backend);
 static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, const GLCContextConfig *config);
+static int glcInitOffscreenContext_Platform(GLCBackend *backend, GLCContext *context,
+        const GLCContextConfig *config, int width, int height);
 static void glcDeinitContext_Platform(GLCBackend *backend, GLCContext *context);
-static void glcMakeContextCurrent_Platform(GLCBackend *backend, GLCContext *context);
+static int glcMakeContextCurrent_Platform(GLCBackend *backend, GLCContext *context);
 static void glcSwapBuffer_Platform(GLCBackend *backend, GLCContext *context);
+static void glcSwapBufferWithDamage_Platform(GLCBackend *backend, GLCContext *context, const int *rects, int rect_count);
+static int glcSetSwapInterval_Platform(GLCBackend *backend, GLCContext *context, int interval);
+static int glcGetSwapInterval_Platform(GLCBackend *backend, GLCContext *context);
+static GLCProc glcGetProcAddress_Platform(const char *name);
+static int glcGetFrameTiming_Platform(GLCBackend *backend, GLCContext *context, GLCFrameTiming *timing);
+static long long glcSwapBufferAtMsc_Platform(GLCBackend *backend, GLCContext *context,
+        long long target_msc, long long divisor, long long remainder);
 
 #endif
 
-#ifdef GLC_DISPLAY_X11
-static int glx_extensions_has(const char *extensions, const char *name) {
+static int glc_extensions_has(const char *extensions, const char *name) {
     const char* start = extensions;
 
     for (;;)
@@ -222,54 +1361,214 @@ static int glx_extensions_has(const char *extensions, const char *name) {
     return 1;
 }
 
-static int choose_glx_framebuffer_config(Display *display, int screenID, 
-        GLCBackend *backend) // TODO: configurable
+// Attributes read once per candidate so scoring never goes back to the driver
+typedef struct glc_framebuffer_attribs {
+    int red_bits, green_bits, blue_bits, alpha_bits;
+    int depth_bits, stencil_bits;
+    int samples;
+    char is_srgb;
+    char has_pbuffer;
+} glc_framebuffer_attribs;
+
+static const GLCFramebufferConfig glc_default_framebuffer = { 8, 8, 8, 8, 24, 8, 0, 0 };
+
+static unsigned int glc_square_diff(int a, int b)
+{
+    return (unsigned int)((a - b) * (a - b));
+}
+
+// Missing buffers weigh the most, then color precision, then every other difference
+static int glc_choose_framebuffer(const GLCFramebufferConfig *desired,
+        const glc_framebuffer_attribs *candidates, int count)
+{
+    int best = -1;
+    unsigned int best_missing = 0, best_color = 0, best_extra = 0;
+
+    for (int i = 0; i < count; ++i) {
+        const glc_framebuffer_attribs *current = &candidates[i];
+
+        unsigned int missing = 0;
+        if (desired->alpha_bits > 0 && current->alpha_bits == 0) ++missing;
+        if (desired->depth_bits > 0 && current->depth_bits == 0) ++missing;
+        if (desired->stencil_bits > 0 && current->stencil_bits == 0) ++missing;
+        if (desired->samples > 0 && current->samples == 0) ++missing;
+        if (desired->use_srgb && !current->is_srgb) ++missing;
+
+        unsigned int color = glc_square_diff(desired->red_bits, current->red_bits) +
+            glc_square_diff(desired->green_bits, current->green_bits) +
+            glc_square_diff(desired->blue_bits, current->blue_bits);
+
+        unsigned int extra = glc_square_diff(desired->alpha_bits, current->alpha_bits) +
+            glc_square_diff(desired->depth_bits, current->depth_bits) +
+            glc_square_diff(desired->stencil_bits, current->stencil_bits) +
+            glc_square_diff(desired->samples, current->samples) +
+            (current->has_pbuffer ? 0 : 1);
+
+        if (best < 0 || missing < best_missing ||
+                (missing == best_missing && (color < best_color ||
+                    (color == best_color && extra < best_extra)))) {
+            best = i;
+            best_missing = missing;
+            best_color = color;
+            best_extra = extra;
+        }
+    }
+
+    return best;
+}
+
+static unsigned int glc_hash(unsigned int hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int glc_hash_int(unsigned int hash, int value)
+{
+    return glc_hash(hash, &value, sizeof(value));
+}
+
+static unsigned int glc_hash_string(unsigned int hash, const char *string)
+{
+    return string ? glc_hash(hash, string, strlen(string) + 1) : glc_hash_int(hash, 0);
+}
+
+// Config IDs are only meaningful for the same driver and request, both are part of the key
+static unsigned int glc_framebuffer_key(const GLCFramebufferConfig *config, const char *vendor,
+        const char *version, int screen)
+{
+    unsigned int hash = 2166136261u;
+    hash = glc_hash_int(hash, config->red_bits);
+    hash = glc_hash_int(hash, config->green_bits);
+    hash = glc_hash_int(hash, config->blue_bits);
+    hash = glc_hash_int(hash, config->alpha_bits);
+    hash = glc_hash_int(hash, config->depth_bits);
+    hash = glc_hash_int(hash, config->stencil_bits);
+    hash = glc_hash_int(hash, config->samples);
+    hash = glc_hash_int(hash, config->use_srgb);
+    hash = glc_hash_string(hash, vendor);
+    hash = glc_hash_string(hash, version);
+    hash = glc_hash_int(hash, screen);
+    return hash;
+}
+
+#define GLC_CONFIG_CACHE_HEADER "glc-config-cache 1"
+
+static int glc_read_config_cache(const char *path, unsigned int key, int *id)
+{
+    FILE *file = fopen(path, "r");
+    if (!file) return 0;
+
+    unsigned int file_key = 0;
+    int file_id = 0;
+    int is_valid = fscanf(file, GLC_CONFIG_CACHE_HEADER " %x %d", &file_key, &file_id) == 2 && file_key == key;
+    fclose(file);
+
+    if (is_valid) *id = file_id;
+    return is_valid;
+}
+
+static void glc_write_config_cache(const char *path, unsigned int key, int id)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        GLC_LOG_MESSAGE("Failed to open framebuffer config cache for writing");
+        return;
+    }
+    fprintf(file, GLC_CONFIG_CACHE_HEADER " %08x %d\n", key, id);
+    fclose(file);
+}
+
+#ifdef GLC_BACKEND_GLX
+
+static void glx_framebuffer_attribs(Display *display, GLXFBConfig fbconfig, const GLCBackend *backend,
+        glc_framebuffer_attribs *attribs)
+{
+    int drawable_type = 0, srgb = 0;
+    memset(attribs, 0, sizeof(*attribs));
+    glXGetFBConfigAttrib(display, fbconfig, GLX_RED_SIZE, &attribs->red_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_GREEN_SIZE, &attribs->green_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_BLUE_SIZE, &attribs->blue_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_ALPHA_SIZE, &attribs->alpha_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_DEPTH_SIZE, &attribs->depth_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_STENCIL_SIZE, &attribs->stencil_bits);
+    glXGetFBConfigAttrib(display, fbconfig, GLX_DRAWABLE_TYPE, &drawable_type);
+    attribs->has_pbuffer = (drawable_type & GLX_PBUFFER_BIT) != 0;
+
+    if (backend->glx.extensions.ARB_multisample)
+        glXGetFBConfigAttrib(display, fbconfig, GLX_SAMPLES_ARB, &attribs->samples);
+
+    if (backend->glx.extensions.ARB_framebuffer_sRGB || backend->glx.extensions.EXT_framebuffer_sRGB) {
+        glXGetFBConfigAttrib(display, fbconfig, GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB, &srgb);
+        attribs->is_srgb = srgb != 0;
+    }
+}
+
+static int choose_glx_framebuffer_config(Display *display, int screenID,
+        GLCBackend *backend, const GLCBackendConfig *config)
 {
-	GLint glx_attribs[] = {
+    const GLCFramebufferConfig *desired = config->framebuffer ? config->framebuffer : &glc_default_framebuffer;
+    unsigned int key = 0;
+
+    if (config->config_cache_path) {
+        key = glc_framebuffer_key(desired, glXQueryServerString(display, screenID, GLX_VENDOR),
+                glXQueryServerString(display, screenID, GLX_VERSION), screenID);
+
+        int id = 0;
+        if (glc_read_config_cache(config->config_cache_path, key, &id)) {
+            // Every other attribute is ignored when GLX_FBCONFIG_ID is given
+            const GLint id_attribs[] = { GLX_FBCONFIG_ID, id, None };
+            int count = 0, visual_id = 0;
+            GLXFBConfig *cached = glXChooseFBConfig(display, screenID, id_attribs, &count);
+            if (cached && count > 0)
+                glXGetFBConfigAttrib(display, cached[0], GLX_VISUAL_ID, &visual_id);
+            if (visual_id) backend->glx.fbconfig = cached[0];
+            if (cached) XFree(cached);
+            if (visual_id) return 1;
+        }
+    }
+
+	const GLint glx_attribs[] = {
 		GLX_X_RENDERABLE    , True,
 		GLX_DRAWABLE_TYPE   , GLX_WINDOW_BIT,
 		GLX_RENDER_TYPE     , GLX_RGBA_BIT,
 		GLX_X_VISUAL_TYPE   , GLX_TRUE_COLOR,
-		GLX_RED_SIZE        , 8,
-		GLX_GREEN_SIZE      , 8,
-		GLX_BLUE_SIZE       , 8,
-		GLX_ALPHA_SIZE      , 8,
-		GLX_DEPTH_SIZE      , 24,
-		GLX_STENCIL_SIZE    , 8,
 		GLX_DOUBLEBUFFER    , True,
 		None
 	};
 
-	int fb_count;
+	int fb_count = 0;
     GLXFBConfig* fbc = glXChooseFBConfig(display, screenID, glx_attribs, &fb_count);
-    if (fbc == 0) {
+    if (fbc == 0 || fb_count == 0) {
+        if (fbc) XFree(fbc);
         GLC_LOG_MESSAGE("Failed to retrive GLX Framebuffer");
         return 0;
     }
 
-	// Pick the FB config/visual with the most samples per pixel
-	int best_fbc = -1, worst_fbc = -1, best_num_samp = -1, worst_num_samp = 999;
-	for (int i = 0; i < fb_count; ++i) {
-		XVisualInfo *vi = glXGetVisualFromFBConfig(display, fbc[i]);
-		if (vi != 0) {
-			int samp_buf, samples;
-			glXGetFBConfigAttrib(display, fbc[i], GLX_SAMPLE_BUFFERS, &samp_buf);
-			glXGetFBConfigAttrib(display, fbc[i], GLX_SAMPLES, &samples);
-
-			if(best_fbc < 0 || (samp_buf && samples > best_num_samp)) {
-				best_fbc = i;
-				best_num_samp = samples;
-			}
-			if(worst_fbc < 0 || !samp_buf || samples < worst_num_samp) {
-				worst_fbc = i;
-            }
-			worst_num_samp = samples;
-		}
-		XFree(vi);
-	}
-
-    backend->glx.fbconfig = fbc[best_fbc];
+    glc_framebuffer_attribs *candidates = (glc_framebuffer_attribs *)GLC_MALLOC(sizeof(*candidates) * (size_t)fb_count);
+    if (!candidates) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for framebuffer candidates");
+        XFree(fbc);
+        return 0;
+    }
+    for (int i = 0; i < fb_count; ++i)
+        glx_framebuffer_attribs(display, fbc[i], backend, &candidates[i]);
+
+    int best = glc_choose_framebuffer(desired, candidates, fb_count);
+    GLC_FREE(candidates);
+
+    backend->glx.fbconfig = fbc[best];
 	XFree(fbc);
+
+    if (config->config_cache_path) {
+        int id = 0;
+        glXGetFBConfigAttrib(display, backend->glx.fbconfig, GLX_FBCONFIG_ID, &id);
+        glc_write_config_cache(config->config_cache_path, key, id);
+    }
     return 1;
 }
 
@@ -299,7 +1598,7 @@ static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *
         return 0;
     }
 
-    if (glx_extensions_has(extensions, "GLX_EXT_swap_control")) {
+    if (glc_extensions_has(extensions, "GLX_EXT_swap_control")) {
         backend->glx.api.SwapIntervalEXT = (PFNGLXSWAPINTERVALEXTPROC)
             glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalEXT");
 
@@ -307,7 +1606,11 @@ static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *
             backend->glx.extensions.EXT_swap_control = 1;
     }
 
-    if (glx_extensions_has(extensions, "GLX_SGI_swap_control")) {
+    if (backend->glx.extensions.EXT_swap_control &&
+            glc_extensions_has(extensions, "GLX_EXT_swap_control_tear"))
+        backend->glx.extensions.EXT_swap_control_tear = 1;
+
+    if (glc_extensions_has(extensions, "GLX_SGI_swap_control")) {
         backend->glx.api.SwapIntervalSGI = (PFNGLXSWAPINTERVALSGIPROC)
             glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalSGI");
 
@@ -315,15 +1618,30 @@ static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *
             backend->glx.extensions.SGI_swap_control = 1;
     }
 
-    if (glx_extensions_has(extensions, "GLX_MESA_swap_control")) {
+    if (glc_extensions_has(extensions, "GLX_MESA_swap_control")) {
         backend->glx.api.SwapIntervalMESA = (PFNGLXSWAPINTERVALMESAPROC)
             glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalMESA");
+        backend->glx.api.GetSwapIntervalMESA = (PFNGLXGETSWAPINTERVALMESAPROC)
+            glXGetProcAddressARB((const GLubyte *)"glXGetSwapIntervalMESA");
 
         if (backend->glx.api.SwapIntervalMESA)
             backend->glx.extensions.MESA_swap_control = 1;
     }
 
-    if (glx_extensions_has(extensions, "GLX_ARB_create_context")) {
+    if (glc_extensions_has(extensions, "GLX_OML_sync_control")) {
+        backend->glx.api.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            glXGetProcAddressARB((const GLubyte *)"glXGetSyncValuesOML");
+        backend->glx.api.SwapBuffersMscOML = (PFNGLXSWAPBUFFERSMSCOMLPROC)
+            glXGetProcAddressARB((const GLubyte *)"glXSwapBuffersMscOML");
+        backend->glx.api.WaitForSbcOML = (PFNGLXWAITFORSBCOMLPROC)
+            glXGetProcAddressARB((const GLubyte *)"glXWaitForSbcOML");
+
+        if (backend->glx.api.GetSyncValuesOML && backend->glx.api.SwapBuffersMscOML &&
+                backend->glx.api.WaitForSbcOML)
+            backend->glx.extensions.OML_sync_control = 1;
+    }
+
+    if (glc_extensions_has(extensions, "GLX_ARB_create_context")) {
         backend->glx.api.CreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC)
             glXGetProcAddressARB((const GLubyte *)"glXCreateContextAttribsARB");
 
@@ -331,24 +1649,25 @@ static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *
             backend->glx.extensions.ARB_create_context = 1;
     }
 
-    if (glx_extensions_has(extensions, "GLX_ARB_multisample"))
+
+    if (glc_extensions_has(extensions, "GLX_ARB_multisample"))
         backend->glx.extensions.ARB_multisample = 1;
-    if (glx_extensions_has(extensions, "GLX_ARB_framebuffer_sRGB"))
+    if (glc_extensions_has(extensions, "GLX_ARB_framebuffer_sRGB"))
         backend->glx.extensions.ARB_framebuffer_sRGB = 1;
-    if (glx_extensions_has(extensions, "GLX_EXT_framebuffer_sRGB"))
+    if (glc_extensions_has(extensions, "GLX_EXT_framebuffer_sRGB"))
         backend->glx.extensions.EXT_framebuffer_sRGB = 1;
-    if (glx_extensions_has(extensions, "GLX_ARB_create_context_robustness"))
+    if (glc_extensions_has(extensions, "GLX_ARB_create_context_robustness"))
         backend->glx.extensions.ARB_create_context_robustness = 1;
-    if (glx_extensions_has(extensions, "GLX_ARB_create_context_profile"))
+    if (glc_extensions_has(extensions, "GLX_ARB_create_context_profile"))
         backend->glx.extensions.ARB_create_context_profile = 1;
-    if (glx_extensions_has(extensions, "GLX_EXT_create_context_es2_profile"))
+    if (glc_extensions_has(extensions, "GLX_EXT_create_context_es2_profile"))
         backend->glx.extensions.EXT_create_context_es2_profile = 1;
-    if (glx_extensions_has(extensions, "GLX_ARB_create_context_no_error"))
+    if (glc_extensions_has(extensions, "GLX_ARB_create_context_no_error"))
         backend->glx.extensions.ARB_create_context_no_error = 1;
-    if (glx_extensions_has(extensions, "GLX_ARB_context_flush_control"))
+    if (glc_extensions_has(extensions, "GLX_ARB_context_flush_control"))
         backend->glx.extensions.ARB_context_flush_control = 1;
 
-    if(!choose_glx_framebuffer_config(display, screenID, backend)) {
+    if(!choose_glx_framebuffer_config(display, screenID, backend, config)) {
         GLC_LOG_MESSAGE("Failed to choose framebuffer config");
         return 0;
     }
@@ -375,9 +1694,14 @@ static void glcDeinitBackend_Platform(GLCBackend *backend)
     XFree(backend->x11.visual_info);
 }
 
-static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, const GLCContextConfig *config)
+static GLCProc glcGetProcAddress_Platform(const char *name)
+{
+    return (GLCProc)glXGetProcAddressARB((const GLubyte *)name);
+}
+
+static GLXContext glx_create_context(GLCBackend *backend, const GLCContextConfig *config)
 {
-    GLXContext share = NULL;
+    GLXContext share = config->share_with ? config->share_with->glx.context : NULL;
     GLXContext result_context = NULL;
 
     if(config->use_opengles) {
@@ -385,14 +1709,14 @@ static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, con
                 !backend->glx.extensions.ARB_create_context_profile ||
                 !backend->glx.extensions.EXT_create_context_es2_profile) {
             GLC_LOG_MESSAGE("GLX: OpenGL ES requested but GLX_EXT_create_context_es2_profile is unavailable");
-            return 0;
+            return NULL;
         }
     }
 
     if (!config->is_backward_compatible) {
         if (!backend->glx.extensions.ARB_create_context) {
             GLC_LOG_MESSAGE("GLX: Forward compatibility requested but GLX_ARB_create_context_profile is unavailable");
-            return 0;
+            return NULL;
         }
     }
 
@@ -405,7 +1729,7 @@ static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, con
                 attribs[index++] = v; \
             } else { \
                 GLC_LOG_MESSAGE("Failed to create opengl context while assigning attribute"); \
-                return 0; \
+                return NULL; \
             } \
         } while(0)
 
@@ -427,6 +1751,20 @@ static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, con
         if (mask) SET_ATTRIB(GLX_CONTEXT_PROFILE_MASK_ARB, mask);
         if (flags) SET_ATTRIB(GLX_CONTEXT_FLAGS_ARB, flags);
 
+        if (config->use_no_error && !config->use_debug_context) {
+            if (backend->glx.extensions.ARB_create_context_no_error)
+                SET_ATTRIB(GLX_CONTEXT_OPENGL_NO_ERROR_ARB, True);
+            else
+                GLC_LOG_MESSAGE("GLX: GLX_ARB_create_context_no_error is unavailable, keeping error checking");
+        }
+
+        if (config->use_no_release_flush) {
+            if (backend->glx.extensions.ARB_context_flush_control)
+                SET_ATTRIB(GLX_CONTEXT_RELEASE_BEHAVIOR_ARB, GLX_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB);
+            else
+                GLC_LOG_MESSAGE("GLX: GLX_ARB_context_flush_control is unavailable, keeping release flush");
+        }
+
         SET_ATTRIB(None, None);
         result_context = backend->glx.api.CreateContextAttribsARB(backend->x11.display,
                 backend->glx.fbconfig,
@@ -442,7 +1780,17 @@ static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, con
                 backend->glx.fbconfig, GLX_RGBA_TYPE, share, True);
     }
 
-    context->glx.context = result_context;
+    return result_context;
+}
+
+static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, const GLCContextConfig *config)
+{
+    context->glx.context = glx_create_context(backend, config);
+    if(!context->glx.context) return 0;
+
+    context->x11.window = config->x11.window;
+    context->glx.pbuffer = None;
+    context->glx.swap_interval = 1;
     context->glx.window = glXCreateWindow(backend->x11.display,
             backend->glx.fbconfig, config->x11.window, NULL);
 
@@ -454,92 +1802,2071 @@ static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, con
     return 1;
 }
 
+static int glcInitOffscreenContext_Platform(GLCBackend *backend, GLCContext *context,
+        const GLCContextConfig *config, int width, int height)
+{
+    context->glx.context = glx_create_context(backend, config);
+    if(!context->glx.context) return 0;
+
+    context->x11.window = None;
+    context->glx.window = None;
+    context->glx.pbuffer = None;
+    context->glx.swap_interval = 0;
+
+    int drawable_type = 0;
+    glXGetFBConfigAttrib(backend->x11.display, backend->glx.fbconfig, GLX_DRAWABLE_TYPE, &drawable_type);
+    if(drawable_type & GLX_PBUFFER_BIT) {
+        const int pbuffer_attribs[] = {
+            GLX_PBUFFER_WIDTH, width,
+            GLX_PBUFFER_HEIGHT, height,
+            None
+        };
+        context->glx.pbuffer = glXCreatePbuffer(backend->x11.display, backend->glx.fbconfig, pbuffer_attribs);
+    }
+
+    // Binding without a drawable needs a context created through GLX_ARB_create_context
+    if(!context->glx.pbuffer && !backend->glx.extensions.ARB_create_context) {
+        GLC_LOG_MESSAGE("GLX: Offscreen context needs pbuffer support or GLX_ARB_create_context");
+        glXDestroyContext(backend->x11.display, context->glx.context);
+        return 0;
+    }
+
+    return 1;
+}
+
 static void glcDeinitContext_Platform(GLCBackend *backend, GLCContext *context)
 {
-    glXDestroyWindow(backend->x11.display, context->glx.window);
+    if(context->glx.window) glXDestroyWindow(backend->x11.display, context->glx.window);
+    if(context->glx.pbuffer) glXDestroyPbuffer(backend->x11.display, context->glx.pbuffer);
     glXDestroyContext(backend->x11.display, context->glx.context);
 }
 
-static void glcMakeContextCurrent_Platform(GLCBackend *backend, GLCContext *context)
+static int glcMakeContextCurrent_Platform(GLCBackend *backend, GLCContext *context)
 {
-    if(context)
-        glXMakeCurrent(backend->x11.display, context->glx.window, context->glx.context);
-    else
-        glXMakeCurrent(backend->x11.display, 0, 0);
+    if(context) {
+        GLXDrawable drawable = context->glx.window ? context->glx.window : context->glx.pbuffer;
+        return glXMakeContextCurrent(backend->x11.display, drawable, drawable, context->glx.context);
+    }
+    return glXMakeContextCurrent(backend->x11.display, None, None, NULL);
 }
 
 static void glcSwapBuffer_Platform(GLCBackend *backend, GLCContext *context)
 {
+    if(!context->glx.window) return;
     glXSwapBuffers(backend->x11.display, context->glx.window);
 }
 
-#endif
+// GLX has no damage extension, the X server sees the whole window change
+static void glcSwapBufferWithDamage_Platform(GLCBackend *backend, GLCContext *context, const int *rects, int rect_count)
+{
+    (void)rects;
+    (void)rect_count;
+    glcSwapBuffer_Platform(backend, context);
+}
 
-GLCBackend *glcCreateBackend(const GLCBackendConfig *config)
+// MESA and SGI variants apply to the current context, bind the context for the
+// call and restore whatever was bound before
+static int glcSetSwapIntervalCurrent_Platform(GLCBackend *backend, GLCContext *context, int interval)
 {
-    if(!config->x11.display) {
-        GLC_LOG_MESSAGE("Expecting a valid X11 in glcCreateBackend()");
-        return NULL;
+    Display *display = backend->x11.display;
+    GLXContext previous_context = glXGetCurrentContext();
+    GLXDrawable previous_draw = glXGetCurrentDrawable();
+    GLXDrawable previous_read = glXGetCurrentReadDrawable();
+    Display *previous_display = glXGetCurrentDisplay();
+    int is_current = previous_context == context->glx.context && previous_draw == context->glx.window;
+
+    if(!is_current && !glXMakeContextCurrent(display, context->glx.window, context->glx.window, context->glx.context)) {
+        GLC_LOG_MESSAGE("GLX: Failed to bind context to set swap interval");
+        return 0;
     }
 
-    GLCBackend *result = (GLCBackend *)GLC_MALLOC(sizeof(*result));
-    if(!result) {
-        GLC_LOG_MESSAGE("Failed to allocate memory for GLCBackend at glcCreateBackend()");
-        return NULL;
+    int result = 0;
+    if(backend->glx.extensions.MESA_swap_control)
+        result = backend->glx.api.SwapIntervalMESA((unsigned int)interval) == 0;
+    else if(interval > 0)
+        result = backend->glx.api.SwapIntervalSGI(interval) == 0;
+
+    if(!is_current) {
+        if(previous_context)
+            glXMakeContextCurrent(previous_display, previous_draw, previous_read, previous_context);
+        else
+            glXMakeContextCurrent(display, None, None, NULL);
+    }
+    return result;
+}
+
+static int glcSetSwapInterval_Platform(GLCBackend *backend, GLCContext *context, int interval)
+{
+    if(!context->glx.window) {
+        GLC_LOG_MESSAGE("GLX: Offscreen contexts have no swap interval");
+        return 0;
     }
 
-    if(!glcInitBackend_Platform(result, config)) {
-        GLC_LOG_MESSAGE("Failed to initialize backend in platform code");
-        GLC_FREE(result);
-        return NULL;
+    if(interval < 0 && !backend->glx.extensions.EXT_swap_control_tear) interval = -interval;
+
+    if(backend->glx.extensions.EXT_swap_control) {
+        // Per drawable, errors are reported asynchronously through the X error handler
+        backend->glx.api.SwapIntervalEXT(backend->x11.display, context->glx.window, interval);
+    } else if(backend->glx.extensions.MESA_swap_control || backend->glx.extensions.SGI_swap_control) {
+        if(interval == 0 && !backend->glx.extensions.MESA_swap_control) {
+            GLC_LOG_MESSAGE("GLX: GLX_SGI_swap_control can't disable vsync");
+            return 0;
+        }
+        if(!glcSetSwapIntervalCurrent_Platform(backend, context, interval)) {
+            GLC_LOG_MESSAGE("GLX: Failed to set swap interval");
+            return 0;
+        }
+    } else {
+        GLC_LOG_MESSAGE("GLX: No swap control extension is available");
+        return 0;
     }
 
-    return result;
+    context->glx.swap_interval = interval;
+    return 1;
 }
 
-void glcDestroyBackend(GLCBackend *backend)
+static int glcGetSwapInterval_Platform(GLCBackend *backend, GLCContext *context)
 {
-    if(!backend) return;
+    if(!context->glx.window) return 0;
+
+    if(backend->glx.extensions.EXT_swap_control) {
+        unsigned int interval = 0, late_swaps_tear = 0;
+        glXQueryDrawable(backend->x11.display, context->glx.window, GLX_SWAP_INTERVAL_EXT, &interval);
+        if(backend->glx.extensions.EXT_swap_control_tear)
+            glXQueryDrawable(backend->x11.display, context->glx.window, GLX_LATE_SWAPS_TEAR_EXT, &late_swaps_tear);
+        return late_swaps_tear ? -(int)interval : (int)interval;
+    }
 
-    glcDeinitBackend_Platform(backend);
-    GLC_FREE(backend);
+    if(backend->glx.extensions.MESA_swap_control && backend->glx.api.GetSwapIntervalMESA &&
+            glXGetCurrentContext() == context->glx.context)
+        return backend->glx.api.GetSwapIntervalMESA();
+
+    return context->glx.swap_interval;
 }
 
-GLCContext *glcCreateContext(GLCBackend *backend, const GLCContextConfig *config)
+static int glcGetFrameTiming_Platform(GLCBackend *backend, GLCContext *context, GLCFrameTiming *timing)
 {
-    if(!backend || !config) {
-        GLC_LOG_MESSAGE("Failed to create context due to invalid function glcCreateContext arguments");
-        return NULL;
+    if(!(context->glx.window && backend->glx.extensions.OML_sync_control)) return 0;
+
+    Display *display = backend->x11.display;
+    int64_t ust, msc, sbc;
+    if(!backend->glx.api.GetSyncValuesOML(display, context->glx.window, &ust, &msc, &sbc)) return 0;
+    // The target is already reached so this returns right away with the
+    // values of the last completed swap instead of the current vblank
+    if(sbc > 0 && !backend->glx.api.WaitForSbcOML(display, context->glx.window, sbc, &ust, &msc, &sbc))
+        return 0;
+
+    if(context->timing.last_sbc >= 0 && sbc > context->timing.last_sbc) {
+        int interval = glcGetSwapInterval_Platform(backend, context);
+        long long per_swap = interval < 0 ? -interval : interval ? interval : 1;
+        long long expected = (sbc - context->timing.last_sbc) * per_swap;
+        long long elapsed = msc - context->timing.last_msc;
+        if(elapsed > expected) context->timing.missed_vblanks += elapsed - expected;
+    }
+    if(sbc > 0) {
+        context->timing.last_msc = msc;
+        context->timing.last_sbc = sbc;
     }
 
-    GLCContext *result = (GLCContext *)GLC_MALLOC(sizeof(*result));
-    if(!glcInitContext_Platform(backend, result, config)) {
-        GLC_FREE(result);
-        return NULL;
+    timing->ust = ust;
+    timing->msc = msc;
+    timing->sbc = sbc;
+    timing->pending = context->timing.swaps > sbc ? context->timing.swaps - sbc : 0;
+    timing->missed_vblanks = context->timing.missed_vblanks;
+    timing->is_estimated = 0;
+    return 1;
+}
+
+static long long glcSwapBufferAtMsc_Platform(GLCBackend *backend, GLCContext *context,
+        long long target_msc, long long divisor, long long remainder)
+{
+    if(!context->glx.window) return -1;
+    if(!backend->glx.extensions.OML_sync_control) {
+        glXSwapBuffers(backend->x11.display, context->glx.window);
+        return -1;
     }
-    return result;
+    return backend->glx.api.SwapBuffersMscOML(backend->x11.display, context->glx.window,
+            target_msc, divisor, remainder);
 }
 
-void glcDestroyContext(GLCBackend *backend, GLCContext *context)
+#endif // GLC_BACKEND_GLX
+
+#ifdef GLC_BACKEND_EGL
+static void egl_framebuffer_attribs(EGLDisplay display, EGLConfig config, glc_framebuffer_attribs *attribs)
 {
-    if(!backend || !context) return;
-    glcDeinitContext_Platform(backend, context);
-    GLC_FREE(context);
+    EGLint surface_type = 0;
+    memset(attribs, 0, sizeof(*attribs));
+    eglGetConfigAttrib(display, config, EGL_RED_SIZE, &attribs->red_bits);
+    eglGetConfigAttrib(display, config, EGL_GREEN_SIZE, &attribs->green_bits);
+    eglGetConfigAttrib(display, config, EGL_BLUE_SIZE, &attribs->blue_bits);
+    eglGetConfigAttrib(display, config, EGL_ALPHA_SIZE, &attribs->alpha_bits);
+    eglGetConfigAttrib(display, config, EGL_DEPTH_SIZE, &attribs->depth_bits);
+    eglGetConfigAttrib(display, config, EGL_STENCIL_SIZE, &attribs->stencil_bits);
+    eglGetConfigAttrib(display, config, EGL_SAMPLES, &attribs->samples);
+    eglGetConfigAttrib(display, config, EGL_SURFACE_TYPE, &surface_type);
+    attribs->has_pbuffer = (surface_type & EGL_PBUFFER_BIT) != 0;
+    // EGL picks the color space per surface, no config is sRGB on its own
+    attribs->is_srgb = 0;
 }
 
-void glcMakeContextCurrent(GLCBackend *backend, GLCContext* context)
+static int egl_choose_config(GLCBackend *backend, const GLCBackendConfig *config)
 {
-    if(!backend) {
-        GLC_LOG_MESSAGE("glcMakeContextCurrent expecting a valid backend");
-        return;
+    const GLCFramebufferConfig *desired = config->framebuffer ? config->framebuffer : &glc_default_framebuffer;
+    EGLint renderable_type = config->egl.use_opengles ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_BIT;
+#ifdef GLC_DISPLAY_SURFACELESS
+    // Surface type 0 matches every config, surfaceless contexts don't need one
+    EGLint surface_type = 0;
+#else
+    EGLint surface_type = EGL_WINDOW_BIT;
+#endif
+    unsigned int key = 0;
+
+    if (config->config_cache_path) {
+        key = glc_framebuffer_key(desired, eglQueryString(backend->egl.display, EGL_VENDOR),
+                eglQueryString(backend->egl.display, EGL_VERSION), renderable_type);
+        key = glc_hash_int(key, surface_type);
+
+        int id = 0;
+        if (glc_read_config_cache(config->config_cache_path, key, &id)) {
+            // Every other attribute is ignored when EGL_CONFIG_ID is given
+            const EGLint id_attribs[] = { EGL_CONFIG_ID, id, EGL_NONE };
+            EGLint count = 0;
+            if (eglChooseConfig(backend->egl.display, id_attribs, &backend->egl.config, 1, &count) && count > 0)
+                return 1;
+        }
+    }
+
+    const EGLint attribs[] = {
+        EGL_SURFACE_TYPE      , surface_type,
+        EGL_RENDERABLE_TYPE   , renderable_type,
+        EGL_COLOR_BUFFER_TYPE , EGL_RGB_BUFFER,
+        EGL_NONE
+    };
+
+    EGLint count = 0;
+    if (!eglChooseConfig(backend->egl.display, attribs, NULL, 0, &count) || count == 0) {
+        GLC_LOG_MESSAGE("Failed to retrive EGL config");
+        return 0;
+    }
+
+    EGLConfig *configs = (EGLConfig *)GLC_MALLOC(sizeof(*configs) * (size_t)count);
+    glc_framebuffer_attribs *candidates = (glc_framebuffer_attribs *)GLC_MALLOC(sizeof(*candidates) * (size_t)count);
+    if (!configs || !candidates) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for framebuffer candidates");
+        if (configs) GLC_FREE(configs);
+        if (candidates) GLC_FREE(candidates);
+        return 0;
+    }
+
+    eglChooseConfig(backend->egl.display, attribs, configs, count, &count);
+    for (int i = 0; i < count; ++i)
+        egl_framebuffer_attribs(backend->egl.display, configs[i], &candidates[i]);
+
+    int best = glc_choose_framebuffer(desired, candidates, count);
+    if (best >= 0) backend->egl.config = configs[best];
+    GLC_FREE(candidates);
+    GLC_FREE(configs);
+
+    if (best < 0) {
+        GLC_LOG_MESSAGE("Failed to retrive EGL config");
+        return 0;
+    }
+
+    if (config->config_cache_path) {
+        EGLint id = 0;
+        eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_CONFIG_ID, &id);
+        glc_write_config_cache(config->config_cache_path, key, id);
     }
-    glcMakeContextCurrent_Platform(backend, context);
+    return 1;
 }
 
-void glcSwapBuffer(GLCBackend *backend, GLCContext *context)
+static int glcInitBackend_Platform(GLCBackend *backend, const GLCBackendConfig *config)
 {
-    if(!(backend && context)) return;
-    glcSwapBuffer_Platform(backend, context);
+#if defined(GLC_DISPLAY_X11)
+    const EGLenum platform = EGL_PLATFORM_X11_KHR;
+    const char *platform_khr = "EGL_KHR_platform_x11", *platform_ext = "EGL_EXT_platform_x11";
+    void *native_display = config->x11.display;
+#elif defined(GLC_DISPLAY_WAYLAND)
+    const EGLenum platform = EGL_PLATFORM_WAYLAND_KHR;
+    const char *platform_khr = "EGL_KHR_platform_wayland", *platform_ext = "EGL_EXT_platform_wayland";
+    void *native_display = config->wayland.display;
+#else
+    const EGLenum platform = EGL_PLATFORM_SURFACELESS_MESA;
+    const char *platform_khr = "EGL_MESA_platform_surfaceless", *platform_ext = platform_khr;
+    void *native_display = EGL_DEFAULT_DISPLAY;
+#endif
+
+    // The KHR platform enums have the same values as their EXT counterparts
+    const char *client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(!client_extensions || !glc_extensions_has(client_extensions, "EGL_EXT_platform_base") ||
+            !(glc_extensions_has(client_extensions, platform_khr) ||
+                glc_extensions_has(client_extensions, platform_ext))) {
+        GLC_LOG_MESSAGE("EGL: The platform extension for the display system is unavailable");
+        return 0;
+    }
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+        eglGetProcAddress("eglGetPlatformDisplayEXT");
+    backend->egl.api.CreatePlatformWindowSurfaceEXT = (PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC)
+        eglGetProcAddress("eglCreatePlatformWindowSurfaceEXT");
+    if(!GetPlatformDisplayEXT || !backend->egl.api.CreatePlatformWindowSurfaceEXT) {
+        GLC_LOG_MESSAGE("EGL: EGL_EXT_platform_base functions are not found");
+        return 0;
+    }
+
+    backend->egl.display = GetPlatformDisplayEXT(platform, native_display, NULL);
+    if(backend->egl.display == EGL_NO_DISPLAY) {
+        GLC_LOG_MESSAGE("EGL: Failed to get platform display");
+        return 0;
+    }
+
+    if(!eglInitialize(backend->egl.display, &backend->egl.major, &backend->egl.minor)) {
+        GLC_LOG_MESSAGE("EGL: Failed to initialize display");
+        return 0;
+    }
+
+    const char *extensions = eglQueryString(backend->egl.display, EGL_EXTENSIONS);
+    if(!extensions) {
+        GLC_LOG_MESSAGE("EGL extensions string is not found");
+        eglTerminate(backend->egl.display);
+        return 0;
+    }
+
+    if(glc_extensions_has(extensions, "EGL_KHR_create_context"))
+        backend->egl.extensions.KHR_create_context = 1;
+    if(glc_extensions_has(extensions, "EGL_KHR_create_context_no_error"))
+        backend->egl.extensions.KHR_create_context_no_error = 1;
+    if(glc_extensions_has(extensions, "EGL_KHR_context_flush_control"))
+        backend->egl.extensions.KHR_context_flush_control = 1;
+    if(glc_extensions_has(extensions, "EGL_KHR_surfaceless_context"))
+        backend->egl.extensions.KHR_surfaceless_context = 1;
+    if(glc_extensions_has(extensions, "EGL_KHR_gl_colorspace"))
+        backend->egl.extensions.KHR_gl_colorspace = 1;
+
+    if(glc_extensions_has(extensions, "EGL_KHR_swap_buffers_with_damage")) {
+        backend->egl.api.SwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+        backend->egl.extensions.KHR_swap_buffers_with_damage = backend->egl.api.SwapBuffersWithDamage != NULL;
+    }
+    if(!backend->egl.api.SwapBuffersWithDamage &&
+            glc_extensions_has(extensions, "EGL_EXT_swap_buffers_with_damage")) {
+        backend->egl.api.SwapBuffersWithDamage = (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+        backend->egl.extensions.EXT_swap_buffers_with_damage = backend->egl.api.SwapBuffersWithDamage != NULL;
+    }
+
+    if(!egl_choose_config(backend, config)) {
+        eglTerminate(backend->egl.display);
+        return 0;
+    }
+    backend->egl.use_srgb = config->framebuffer && config->framebuffer->use_srgb;
+
+#ifdef GLC_DISPLAY_X11
+    // Windows have to be created with this visual to get an EGL surface
+    XVisualInfo visual_template;
+    EGLint visual_id = 0, visual_count = 0;
+    eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_NATIVE_VISUAL_ID, &visual_id);
+    visual_template.visualid = (VisualID)visual_id;
+    backend->x11.visual_info = XGetVisualInfo(config->x11.display, VisualIDMask, &visual_template, &visual_count);
+    if(!backend->x11.visual_info) {
+        GLC_LOG_MESSAGE("Could not create correct visual info");
+        eglTerminate(backend->egl.display);
+        return 0;
+    }
+    backend->x11.display = config->x11.display;
+#endif
+
+    return 1;
+}
+
+static void glcDeinitBackend_Platform(GLCBackend *backend)
+{
+#ifdef GLC_DISPLAY_X11
+    XFree(backend->x11.visual_info);
+#endif
+    eglTerminate(backend->egl.display);
+}
+
+static GLCProc glcGetProcAddress_Platform(const char *name)
+{
+    return (GLCProc)eglGetProcAddress(name);
+}
+
+static EGLContext egl_create_context(GLCBackend *backend, const GLCContextConfig *config)
+{
+    EGLContext share = config->share_with ? config->share_with->egl.context : EGL_NO_CONTEXT;
+
+    if(!eglBindAPI(config->use_opengles ? EGL_OPENGL_ES_API : EGL_OPENGL_API)) {
+        GLC_LOG_MESSAGE("EGL: Failed to bind the requested client API");
+        return EGL_NO_CONTEXT;
+    }
+
+    EGLint attribs[20];
+    int index = 0;
+    if(backend->egl.extensions.KHR_create_context) {
+        int mask = 0, flags = 0;
+        if(!config->use_opengles) {
+            if (config->is_core_profile) mask |= EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR;
+            else mask |= EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR;
+        }
+        if (config->use_debug_context) flags |= EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+
+        if (config->version.major != 1 || config->version.minor != 0) {
+            attribs[index++] = EGL_CONTEXT_MAJOR_VERSION_KHR;
+            attribs[index++] = config->version.major;
+            attribs[index++] = EGL_CONTEXT_MINOR_VERSION_KHR;
+            attribs[index++] = config->version.minor;
+        }
+        if (mask) {
+            attribs[index++] = EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR;
+            attribs[index++] = mask;
+        }
+        if (flags) {
+            attribs[index++] = EGL_CONTEXT_FLAGS_KHR;
+            attribs[index++] = flags;
+        }
+    } else if(config->use_opengles) {
+        attribs[index++] = EGL_CONTEXT_CLIENT_VERSION;
+        attribs[index++] = config->version.major;
+    }
+
+    if (config->use_no_error && !config->use_debug_context) {
+        if (backend->egl.extensions.KHR_create_context_no_error) {
+            attribs[index++] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+            attribs[index++] = EGL_TRUE;
+        } else {
+            GLC_LOG_MESSAGE("EGL: EGL_KHR_create_context_no_error is unavailable, keeping error checking");
+        }
+    }
+
+    if (config->use_no_release_flush) {
+        if (backend->egl.extensions.KHR_context_flush_control) {
+            attribs[index++] = EGL_CONTEXT_RELEASE_BEHAVIOR_KHR;
+            attribs[index++] = EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR;
+        } else {
+            GLC_LOG_MESSAGE("EGL: EGL_KHR_context_flush_control is unavailable, keeping release flush");
+        }
+    }
+    attribs[index++] = EGL_NONE;
+
+    EGLContext result_context = eglCreateContext(backend->egl.display, backend->egl.config, share, attribs);
+    if(result_context == EGL_NO_CONTEXT) {
+        GLC_LOG_MESSAGE("Failed to create EGL context");
+    }
+    return result_context;
+}
+
+static int glcInitContext_Platform(GLCBackend *backend, GLCContext *context, const GLCContextConfig *config)
+{
+#ifdef GLC_DISPLAY_SURFACELESS
+    (void)backend;
+    (void)context;
+    (void)config;
+    GLC_LOG_MESSAGE("EGL: Surfaceless display has no windows, use glcCreateOffscreenContext()");
+    return 0;
+#else
+#ifdef GLC_DISPLAY_X11
+    // EGL_KHR_platform_x11 takes a pointer to the Window
+    context->x11.window = config->x11.window;
+    void *native_window = &context->x11.window;
+#else
+    void *native_window = config->wayland.window;
+#endif
+    if(!native_window) {
+        GLC_LOG_MESSAGE("EGL: Expecting a window in the context config");
+        return 0;
+    }
+
+    EGLint surface_attribs[3] = { EGL_NONE, EGL_NONE, EGL_NONE };
+    if(backend->egl.use_srgb) {
+        if(backend->egl.extensions.KHR_gl_colorspace) {
+            surface_attribs[0] = EGL_GL_COLORSPACE_KHR;
+            surface_attribs[1] = EGL_GL_COLORSPACE_SRGB_KHR;
+        } else {
+            GLC_LOG_MESSAGE("EGL: EGL_KHR_gl_colorspace is unavailable, the window surface is linear");
+        }
+    }
+
+    context->egl.surface = backend->egl.api.CreatePlatformWindowSurfaceEXT(backend->egl.display,
+            backend->egl.config, native_window, surface_attribs);
+    if(context->egl.surface == EGL_NO_SURFACE) {
+        GLC_LOG_MESSAGE("EGL: Failed to create window surface");
+        return 0;
+    }
+
+    context->egl.context = egl_create_context(backend, config);
+    if(context->egl.context == EGL_NO_CONTEXT) {
+        eglDestroySurface(backend->egl.display, context->egl.surface);
+        return 0;
+    }
+    context->egl.has_window = 1;
+    context->egl.swap_interval = 1;
+    return 1;
+#endif
+}
+
+static int glcInitOffscreenContext_Platform(GLCBackend *backend, GLCContext *context,
+        const GLCContextConfig *config, int width, int height)
+{
+    context->egl.context = egl_create_context(backend, config);
+    if(context->egl.context == EGL_NO_CONTEXT) return 0;
+    context->egl.surface = EGL_NO_SURFACE;
+#ifdef GLC_DISPLAY_X11
+    context->x11.window = None;
+#endif
+
+    EGLint surface_type = 0;
+    eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_SURFACE_TYPE, &surface_type);
+    if(surface_type & EGL_PBUFFER_BIT) {
+        const EGLint pbuffer_attribs[] = {
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_NONE
+        };
+        context->egl.surface = eglCreatePbufferSurface(backend->egl.display, backend->egl.config, pbuffer_attribs);
+    }
+
+    if(context->egl.surface == EGL_NO_SURFACE && !backend->egl.extensions.KHR_surfaceless_context) {
+        GLC_LOG_MESSAGE("EGL: Offscreen context needs pbuffer support or EGL_KHR_surfaceless_context");
+        eglDestroyContext(backend->egl.display, context->egl.context);
+        return 0;
+    }
+
+    return 1;
+}
+
+static void glcDeinitContext_Platform(GLCBackend *backend, GLCContext *context)
+{
+    if(context->egl.surface != EGL_NO_SURFACE) eglDestroySurface(backend->egl.display, context->egl.surface);
+    eglDestroyContext(backend->egl.display, context->egl.context);
+}
+
+static int glcMakeContextCurrent_Platform(GLCBackend *backend, GLCContext *context)
+{
+    if(context)
+        return eglMakeCurrent(backend->egl.display, context->egl.surface, context->egl.surface, context->egl.context);
+    return eglMakeCurrent(backend->egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+static void glcSwapBuffer_Platform(GLCBackend *backend, GLCContext *context)
+{
+    // Pbuffers are single buffered, flush so the results become visible
+    if(!context->egl.has_window) {
+        glFlush();
+        return;
+    }
+    eglSwapBuffers(backend->egl.display, context->egl.surface);
+}
+
+static void glcSwapBufferWithDamage_Platform(GLCBackend *backend, GLCContext *context, const int *rects, int rect_count)
+{
+    if(!(context->egl.has_window && backend->egl.api.SwapBuffersWithDamage && rects && rect_count > 0)) {
+        glcSwapBuffer_Platform(backend, context);
+        return;
+    }
+    backend->egl.api.SwapBuffersWithDamage(backend->egl.display, context->egl.surface,
+            (const EGLint *)rects, rect_count);
+}
+
+// eglSwapInterval applies to the current surface, bind the context for the
+// call and restore whatever was bound before
+static int glcSetSwapInterval_Platform(GLCBackend *backend, GLCContext *context, int interval)
+{
+    if(!context->egl.has_window) {
+        GLC_LOG_MESSAGE("EGL: Offscreen contexts have no swap interval");
+        return 0;
+    }
+
+    // EGL has no adaptive vsync
+    if(interval < 0) interval = -interval;
+
+    EGLDisplay previous_display = eglGetCurrentDisplay();
+    EGLContext previous_context = eglGetCurrentContext();
+    EGLSurface previous_draw = eglGetCurrentSurface(EGL_DRAW);
+    EGLSurface previous_read = eglGetCurrentSurface(EGL_READ);
+    int is_current = previous_context == context->egl.context && previous_draw == context->egl.surface;
+
+    if(!is_current && !eglMakeCurrent(backend->egl.display, context->egl.surface,
+                context->egl.surface, context->egl.context)) {
+        GLC_LOG_MESSAGE("EGL: Failed to bind context to set swap interval");
+        return 0;
+    }
+
+    int result = eglSwapInterval(backend->egl.display, interval);
+
+    if(!is_current) {
+        if(previous_context != EGL_NO_CONTEXT)
+            eglMakeCurrent(previous_display, previous_draw, previous_read, previous_context);
+        else
+            eglMakeCurrent(backend->egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+    if(!result) {
+        GLC_LOG_MESSAGE("EGL: Failed to set swap interval");
+        return 0;
+    }
+    // The implementation clamps to EGL_MIN_SWAP_INTERVAL and EGL_MAX_SWAP_INTERVAL
+    EGLint min_interval = 0, max_interval = interval;
+    eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_MIN_SWAP_INTERVAL, &min_interval);
+    eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_MAX_SWAP_INTERVAL, &max_interval);
+    context->egl.swap_interval = interval < min_interval ? min_interval : interval > max_interval ? max_interval : interval;
+    return 1;
+}
+
+static int glcGetSwapInterval_Platform(GLCBackend *backend, GLCContext *context)
+{
+    (void)backend;
+    return context->egl.has_window ? context->egl.swap_interval : 0;
+}
+
+// No present feedback on EGL, the CPU clock estimate is used instead
+static int glcGetFrameTiming_Platform(GLCBackend *backend, GLCContext *context, GLCFrameTiming *timing)
+{
+    (void)backend;
+    (void)context;
+    (void)timing;
+    return 0;
+}
+
+static long long glcSwapBufferAtMsc_Platform(GLCBackend *backend, GLCContext *context,
+        long long target_msc, long long divisor, long long remainder)
+{
+    (void)target_msc;
+    (void)divisor;
+    (void)remainder;
+    glcSwapBuffer_Platform(backend, context);
+    return -1;
+}
+#endif // GLC_BACKEND_EGL
+
+static void glc_load_sync_functions(GLCBackend *backend)
+{
+    // Core since OpenGL 3.2, checked when a fence is created
+    backend->gl.FenceSync = (PFNGLFENCESYNCPROC)glcGetProcAddress_Platform("glFenceSync");
+    backend->gl.ClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)glcGetProcAddress_Platform("glClientWaitSync");
+    backend->gl.WaitSync = (PFNGLWAITSYNCPROC)glcGetProcAddress_Platform("glWaitSync");
+    backend->gl.DeleteSync = (PFNGLDELETESYNCPROC)glcGetProcAddress_Platform("glDeleteSync");
+}
+
+GLCBackend *glcCreateBackend(const GLCBackendConfig *config)
+{
+    if(!config) {
+        GLC_LOG_MESSAGE("Expecting a valid config in glcCreateBackend()");
+        return NULL;
+    }
+
+#ifdef GLC_DISPLAY_X11
+    if(!config->x11.display) {
+        GLC_LOG_MESSAGE("Expecting a valid X11 in glcCreateBackend()");
+        return NULL;
+    }
+#endif
+#ifdef GLC_DISPLAY_WAYLAND
+    if(!config->wayland.display) {
+        GLC_LOG_MESSAGE("Expecting a valid wl_display in glcCreateBackend()");
+        return NULL;
+    }
+#endif
+
+    GLCBackend *result = (GLCBackend *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCBackend at glcCreateBackend()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+
+    if(!glcInitBackend_Platform(result, config)) {
+        GLC_LOG_MESSAGE("Failed to initialize backend in platform code");
+        GLC_FREE(result);
+        return NULL;
+    }
+    glc_load_sync_functions(result);
+
+    return result;
+}
+
+void glcDestroyBackend(GLCBackend *backend)
+{
+    if(!backend) return;
+
+#ifdef GLC_USE_FUNCTIONS
+    if(backend->functions) GLC_FREE(backend->functions);
+    if(backend->function_index) GLC_FREE(backend->function_index);
+#endif
+    glcDeinitBackend_Platform(backend);
+    GLC_FREE(backend);
+}
+
+GLCContext *glcCreateContext(GLCBackend *backend, const GLCContextConfig *config)
+{
+    if(!backend || !config) {
+        GLC_LOG_MESSAGE("Failed to create context due to invalid function glcCreateContext arguments");
+        return NULL;
+    }
+
+    GLCContext *result = (GLCContext *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCContext at glcCreateContext()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+    result->timing.last_sbc = -1;
+
+    if(!glcInitContext_Platform(backend, result, config)) {
+        GLC_FREE(result);
+        return NULL;
+    }
+    return result;
+}
+
+GLCContext *glcCreateOffscreenContext(GLCBackend *backend, const GLCContextConfig *config, int width, int height)
+{
+    if(!backend || !config || width <= 0 || height <= 0) {
+        GLC_LOG_MESSAGE("Failed to create context due to invalid function glcCreateOffscreenContext arguments");
+        return NULL;
+    }
+
+    GLCContext *result = (GLCContext *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCContext at glcCreateOffscreenContext()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+    result->timing.last_sbc = -1;
+
+    if(!glcInitOffscreenContext_Platform(backend, result, config, width, height)) {
+        GLC_FREE(result);
+        return NULL;
+    }
+    return result;
+}
+
+GLCContext *glcCreateWorkerContext(GLCBackend *backend, const GLCContextConfig *config)
+{
+    // Loader threads never draw to the default framebuffer
+    return glcCreateOffscreenContext(backend, config, 1, 1);
+}
+
+// A context's drawable never changes, so the context alone identifies the binding
+static GLC_THREAD_LOCAL GLCContext *glc_current_context;
+static GLC_THREAD_LOCAL GLCMakeCurrentStats glc_make_current_stats;
+
+void glcDestroyContext(GLCBackend *backend, GLCContext *context)
+{
+    if(!backend || !context) return;
+    if(glc_current_context == context) {
+        glcMakeContextCurrent_Platform(backend, NULL);
+        glc_current_context = NULL;
+    }
+    glcDeinitContext_Platform(backend, context);
+    GLC_FREE(context);
+}
+
+void glcMakeContextCurrent(GLCBackend *backend, GLCContext* context)
+{
+    if(!backend) {
+        GLC_LOG_MESSAGE("glcMakeContextCurrent expecting a valid backend");
+        return;
+    }
+
+    if(glc_current_context == context) {
+        glc_make_current_stats.skipped += 1;
+        return;
+    }
+
+    glc_make_current_stats.binds += 1;
+    if(!glcMakeContextCurrent_Platform(backend, context)) {
+        GLC_LOG_MESSAGE("Failed to make context current");
+        return;
+    }
+    glc_current_context = context;
+}
+
+GLCContext *glcGetCurrentContext(void)
+{
+    return glc_current_context;
+}
+
+void glcGetMakeCurrentStats(GLCMakeCurrentStats *stats)
+{
+    if(!stats) return;
+    *stats = glc_make_current_stats;
+}
+
+static long long glc_time_ns(void)
+{
+#ifdef GLC_DISPLAY_WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (long long)(counter.QuadPart / frequency.QuadPart * 1000000000 +
+            counter.QuadPart % frequency.QuadPart * 1000000000 / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+// Keeps the CPU clock estimate of glcGetFrameTiming, called once the swap returned
+static void glc_record_swap(GLCContext *context)
+{
+    long long now = glc_time_ns() / 1000;
+    long long average = context->timing.average_period_us;
+
+    context->timing.swaps++;
+    if(context->timing.last_swap_us) {
+        long long period = now - context->timing.last_swap_us;
+        // Swaps 1.5x later than usual count the refreshes they spanned as
+        // missed, they are kept out of the average so a hitch doesn't hide the next one
+        if(average && period > average + average / 2)
+            context->timing.estimated_missed += (period + average / 2) / average - 1;
+        else
+            context->timing.average_period_us = average ? (average * 7 + period) / 8 : period;
+    }
+    context->timing.last_swap_us = now;
+}
+
+// Windows that don't pace a group keep interval 0 across frames, the driver is
+// only touched when a window switches role
+static void glc_set_paced(GLCBackend *backend, GLCContext *context, int is_paced)
+{
+    if(is_paced) {
+        if(!context->group.is_unpaced) return;
+        context->group.is_unpaced = 0;
+        glcSetSwapInterval_Platform(backend, context, context->group.interval);
+        return;
+    }
+
+    if(context->group.is_unpaced || context->group.is_unsupported) return;
+    int interval = glcGetSwapInterval_Platform(backend, context);
+    if(interval == 0) return;
+    if(!glcSetSwapInterval_Platform(backend, context, 0)) {
+        context->group.is_unsupported = 1;
+        return;
+    }
+    context->group.interval = interval;
+    context->group.is_unpaced = 1;
+}
+
+void glcSwapBuffer(GLCBackend *backend, GLCContext *context)
+{
+    if(!(backend && context)) return;
+    glc_set_paced(backend, context, 1);
+    glcSwapBuffer_Platform(backend, context);
+    glc_record_swap(context);
+}
+
+void glcSwapBuffers(GLCBackend *backend, GLCContext **contexts, int count, GLCFrameTiming *timings)
+{
+    if(!(backend && contexts) || count <= 0) return;
+
+#ifdef GLC_BACKEND_EGL
+    GLCContext *previous = glc_current_context;
+#endif
+    for(int i = 0; i < count; ++i) {
+        if(!contexts[i]) continue;
+        glc_set_paced(backend, contexts[i], i == count - 1);
+#ifdef GLC_BACKEND_EGL
+        // EGL only swaps surfaces current on the calling thread
+        glcMakeContextCurrent(backend, contexts[i]);
+#endif
+        glcSwapBuffer_Platform(backend, contexts[i]);
+        glc_record_swap(contexts[i]);
+    }
+#ifdef GLC_BACKEND_EGL
+    glcMakeContextCurrent(backend, previous);
+#endif
+
+    if(!timings) return;
+    for(int i = 0; i < count; ++i) {
+        if(!(contexts[i] && glcGetFrameTiming(backend, contexts[i], &timings[i])))
+            memset(&timings[i], 0, sizeof(timings[i]));
+    }
+}
+
+void glcSwapBufferWithDamage(GLCBackend *backend, GLCContext *context, const int *rects, int rect_count)
+{
+    if(!(backend && context)) return;
+    glc_set_paced(backend, context, 1);
+    glcSwapBufferWithDamage_Platform(backend, context, rects, rect_count);
+    glc_record_swap(context);
+}
+
+long long glcSwapBufferAtMsc(GLCBackend *backend, GLCContext *context,
+        long long target_msc, long long divisor, long long remainder)
+{
+    if(!(backend && context) || target_msc < 0 || divisor < 0 || (divisor && remainder >= divisor)) return -1;
+    glc_set_paced(backend, context, 1);
+    long long sbc = glcSwapBufferAtMsc_Platform(backend, context, target_msc, divisor, remainder);
+    glc_record_swap(context);
+    return sbc;
+}
+
+int glcGetFrameTiming(GLCBackend *backend, GLCContext *context, GLCFrameTiming *timing)
+{
+    if(!(backend && context && timing)) return 0;
+    if(glcGetFrameTiming_Platform(backend, context, timing)) return 1;
+
+    timing->ust = context->timing.last_swap_us;
+    timing->msc = context->timing.swaps + context->timing.estimated_missed;
+    timing->sbc = context->timing.swaps;
+    timing->pending = 0;
+    timing->missed_vblanks = context->timing.estimated_missed;
+    timing->is_estimated = 1;
+    return 1;
+}
+
+int glcSetSwapInterval(GLCBackend *backend, GLCContext *context, int interval)
+{
+    if(!(backend && context)) return 0;
+    context->group.is_unpaced = 0;
+    context->group.is_unsupported = 0;
+    return glcSetSwapInterval_Platform(backend, context, interval);
+}
+
+int glcGetSwapInterval(GLCBackend *backend, GLCContext *context)
+{
+    if(!(backend && context)) return 0;
+    if(context->group.is_unpaced) return context->group.interval;
+    return glcGetSwapInterval_Platform(backend, context);
+}
+
+GLCFence glcCreateFence(GLCBackend *backend)
+{
+    if(!backend) return NULL;
+    if(!backend->gl.FenceSync) {
+        GLC_LOG_MESSAGE("glcCreateFence requires OpenGL 3.2 or GL_ARB_sync");
+        return NULL;
+    }
+
+    GLCFence fence = (GLCFence)backend->gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // The fence must reach the GPU before another context waits on it
+    glFlush();
+    return fence;
+}
+
+void glcWaitFence(GLCBackend *backend, GLCFence fence)
+{
+    if(!(backend && fence)) return;
+    backend->gl.WaitSync((GLsync)fence, 0, GL_TIMEOUT_IGNORED);
+}
+
+int glcClientWaitFence(GLCBackend *backend, GLCFence fence, unsigned long long timeout_ns)
+{
+    if(!(backend && fence)) return 0;
+    GLenum status = backend->gl.ClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)timeout_ns);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void glcDestroyFence(GLCBackend *backend, GLCFence fence)
+{
+    if(!(backend && fence)) return;
+    backend->gl.DeleteSync((GLsync)fence);
+}
+
+#ifdef GLC_USE_FUNCTIONS
+static const char *const glc_function_names[GLC_FUNCTION_COUNT] = {
+#define GLC_FUNCTION_NAME(type, name, params) "gl" #name,
+    GLC_GL_FUNCTIONS(GLC_FUNCTION_NAME)
+#undef GLC_FUNCTION_NAME
+};
+
+// Open addressing table from FNV-1a name hashes to table slots, built at
+// runtime with the table. It only lets later glcGetProcAddress calls for core
+// names skip the loader. Power of two, at least twice GLC_FUNCTION_COUNT.
+#define GLC_FUNCTION_INDEX_CAPACITY 2048
+
+static unsigned int glc_hash_name(const char *name)
+{
+    return glc_hash(2166136261u, name, strlen(name));
+}
+
+static int glc_load_functions(GLCBackend *backend)
+{
+    backend->functions = (GLCFunctions *)GLC_MALLOC(sizeof(*backend->functions));
+    backend->function_index = (unsigned short *)GLC_MALLOC(sizeof(*backend->function_index) * GLC_FUNCTION_INDEX_CAPACITY);
+    if(!backend->functions || !backend->function_index) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCFunctions");
+        if(backend->functions) GLC_FREE(backend->functions);
+        if(backend->function_index) GLC_FREE(backend->function_index);
+        backend->functions = NULL;
+        backend->function_index = NULL;
+        return 0;
+    }
+    memset(backend->function_index, 0, sizeof(*backend->function_index) * GLC_FUNCTION_INDEX_CAPACITY);
+
+    for(unsigned int i = 0; i < GLC_FUNCTION_COUNT; ++i) {
+        backend->functions->procs[i] = glcGetProcAddress_Platform(glc_function_names[i]);
+
+        unsigned int slot = glc_hash_name(glc_function_names[i]) & (GLC_FUNCTION_INDEX_CAPACITY - 1);
+        while(backend->function_index[slot]) slot = (slot + 1) & (GLC_FUNCTION_INDEX_CAPACITY - 1);
+        backend->function_index[slot] = (unsigned short)(i + 1);
+    }
+    return 1;
+}
+
+const GLCFunctions *glcGetFunctions(GLCBackend *backend)
+{
+    if(!backend) return NULL;
+    if(!backend->functions && !glc_load_functions(backend)) return NULL;
+    return backend->functions;
+}
+#endif
+
+GLCProc glcGetProcAddress(GLCBackend *backend, const char *name)
+{
+    if(!(backend && name)) return NULL;
+
+#ifdef GLC_USE_FUNCTIONS
+    if(backend->function_index) {
+        unsigned int slot = glc_hash_name(name) & (GLC_FUNCTION_INDEX_CAPACITY - 1);
+        for(; backend->function_index[slot]; slot = (slot + 1) & (GLC_FUNCTION_INDEX_CAPACITY - 1)) {
+            unsigned int index = backend->function_index[slot] - 1u;
+            if(strcmp(glc_function_names[index], name) == 0) return backend->functions->procs[index];
+        }
+    }
+#endif
+    return glcGetProcAddress_Platform(name);
+}
+
+#ifdef GLC_DISPLAY_X11
+int glcGetX11Visual(GLCBackend *backend, unsigned long *visual_id, int *depth)
+{
+    if(!(backend && backend->x11.visual_info)) return 0;
+    if(visual_id) *visual_id = backend->x11.visual_info->visualid;
+    if(depth) *depth = backend->x11.visual_info->depth;
+    return 1;
+}
+#endif
+
+#if defined(SWL_H_) && defined(SWL_DISPLAY_X11) && defined(GLC_DISPLAY_X11)
+swl_window *glcCreateSwlWindow(GLCBackend *backend, const swl_window_config *config)
+{
+    unsigned long visual_id;
+    int depth;
+    if(!(config && glcGetX11Visual(backend, &visual_id, &depth))) {
+        GLC_LOG_MESSAGE("Failed to create window due to invalid function glcCreateSwlWindow arguments");
+        return NULL;
+    }
+
+    return swl_create_window_with_visual(config, (swl_uint32)visual_id, (swl_uint32)depth);
+}
+#endif
+
+#ifdef GLC_USE_PROFILER
+// Deepest zone nesting recorded, deeper zones are dropped
+#define GLC_PROFILER_MAX_DEPTH 32
+
+typedef struct glc_profiler_slot {
+    GLCProfilerZone *zones;
+    // Begin and end timestamp query of every zone
+    GLuint *queries;
+    int zone_count;
+    int dropped_zones;
+    unsigned long long index;
+    // GPU timestamp minus CPU clock, sampled when the frame began
+    long long gpu_offset_ns;
+    char is_pending;
+} glc_profiler_slot;
+
+struct GLCProfiler {
+    int max_zones;
+    glc_profiler_slot slots[GLC_PROFILER_LATENCY];
+    // Slot being recorded, -1 between frames
+    int current;
+    unsigned long long frame_index;
+    int stack[GLC_PROFILER_MAX_DEPTH];
+    int depth;
+    // Open zones that were dropped, their ends are ignored
+    int ignored_depth;
+    struct {
+        GLCProfilerZone *zones;
+        int zone_count;
+        int dropped_zones;
+        unsigned long long index;
+        char is_valid;
+    } result;
+    unsigned long long dropped_frames;
+    struct {
+        PFNGLGENQUERIESPROC GenQueries;
+        PFNGLDELETEQUERIESPROC DeleteQueries;
+        PFNGLGETQUERYIVPROC GetQueryiv;
+        PFNGLQUERYCOUNTERPROC QueryCounter;
+        PFNGLGETQUERYOBJECTIVPROC GetQueryObjectiv;
+        PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+        PFNGLGETINTEGER64VPROC GetInteger64v;
+    } gl;
+};
+
+GLCProfiler *glcCreateProfiler(GLCBackend *backend, GLCContext *context, int max_zones)
+{
+    if(!backend || !context || max_zones <= 0) {
+        GLC_LOG_MESSAGE("Failed to create profiler due to invalid function glcCreateProfiler arguments");
+        return NULL;
+    }
+
+    GLCProfiler *result = (GLCProfiler *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCProfiler at glcCreateProfiler()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+    result->max_zones = max_zones;
+    result->current = -1;
+
+    result->gl.GenQueries = (PFNGLGENQUERIESPROC)glcGetProcAddress(backend, "glGenQueries");
+    result->gl.DeleteQueries = (PFNGLDELETEQUERIESPROC)glcGetProcAddress(backend, "glDeleteQueries");
+    result->gl.GetQueryiv = (PFNGLGETQUERYIVPROC)glcGetProcAddress(backend, "glGetQueryiv");
+    result->gl.QueryCounter = (PFNGLQUERYCOUNTERPROC)glcGetProcAddress(backend, "glQueryCounter");
+    result->gl.GetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)glcGetProcAddress(backend, "glGetQueryObjectiv");
+    result->gl.GetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)glcGetProcAddress(backend, "glGetQueryObjectui64v");
+    result->gl.GetInteger64v = (PFNGLGETINTEGER64VPROC)glcGetProcAddress(backend, "glGetInteger64v");
+
+    GLint counter_bits = 0;
+    if(!(result->gl.GenQueries && result->gl.DeleteQueries && result->gl.GetQueryiv &&
+            result->gl.QueryCounter && result->gl.GetQueryObjectiv &&
+            result->gl.GetQueryObjectui64v && result->gl.GetInteger64v)) {
+        GLC_LOG_MESSAGE("Timer query functions are not available");
+        GLC_FREE(result);
+        return NULL;
+    }
+    result->gl.GetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counter_bits);
+    if(counter_bits == 0) {
+        GLC_LOG_MESSAGE("The context has no GPU timestamps");
+        GLC_FREE(result);
+        return NULL;
+    }
+
+    result->result.zones = (GLCProfilerZone *)GLC_MALLOC(sizeof(GLCProfilerZone) * (size_t)max_zones);
+    int is_allocated = result->result.zones != NULL;
+    for(int i = 0; i < GLC_PROFILER_LATENCY && is_allocated; ++i) {
+        glc_profiler_slot *slot = &result->slots[i];
+        slot->zones = (GLCProfilerZone *)GLC_MALLOC(sizeof(GLCProfilerZone) * (size_t)max_zones);
+        slot->queries = (GLuint *)GLC_MALLOC(sizeof(GLuint) * 2 * (size_t)max_zones);
+        is_allocated = slot->zones && slot->queries;
+        if(slot->queries) result->gl.GenQueries(2 * max_zones, slot->queries);
+    }
+    if(!is_allocated) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for profiler zones at glcCreateProfiler()");
+        glcDestroyProfiler(result);
+        return NULL;
+    }
+    return result;
+}
+
+void glcDestroyProfiler(GLCProfiler *profiler)
+{
+    if(!profiler) return;
+    for(int i = 0; i < GLC_PROFILER_LATENCY; ++i) {
+        glc_profiler_slot *slot = &profiler->slots[i];
+        if(slot->queries) {
+            profiler->gl.DeleteQueries(2 * profiler->max_zones, slot->queries);
+            GLC_FREE(slot->queries);
+        }
+        if(slot->zones) GLC_FREE(slot->zones);
+    }
+    if(profiler->result.zones) GLC_FREE(profiler->result.zones);
+    GLC_FREE(profiler);
+}
+
+// Copies the slot into the result if its queries are ready, never waits
+static int glc_profiler_resolve(GLCProfiler *profiler, glc_profiler_slot *slot)
+{
+    GLint is_available = 0;
+    // The frame's end timestamp is written last
+    profiler->gl.GetQueryObjectiv(slot->queries[1], GL_QUERY_RESULT_AVAILABLE, &is_available);
+    if(!is_available) return 0;
+
+    for(int i = 0; i < slot->zone_count; ++i) {
+        GLCProfilerZone *zone = &profiler->result.zones[i];
+        GLuint64 begin = 0, end = 0;
+        profiler->gl.GetQueryObjectui64v(slot->queries[2 * i], GL_QUERY_RESULT, &begin);
+        profiler->gl.GetQueryObjectui64v(slot->queries[2 * i + 1], GL_QUERY_RESULT, &end);
+        *zone = slot->zones[i];
+        zone->gpu_begin_ns = (unsigned long long)((long long)begin - slot->gpu_offset_ns);
+        zone->gpu_end_ns = (unsigned long long)((long long)end - slot->gpu_offset_ns);
+    }
+    profiler->result.zone_count = slot->zone_count;
+    profiler->result.dropped_zones = slot->dropped_zones;
+    profiler->result.index = slot->index;
+    profiler->result.is_valid = 1;
+    slot->is_pending = 0;
+    return 1;
+}
+
+void glcProfilerBeginZone(GLCProfiler *profiler, const char *name)
+{
+    if(!profiler || profiler->current < 0) return;
+    glc_profiler_slot *slot = &profiler->slots[profiler->current];
+
+    if(profiler->ignored_depth || slot->zone_count == profiler->max_zones ||
+            profiler->depth == GLC_PROFILER_MAX_DEPTH) {
+        profiler->ignored_depth++;
+        slot->dropped_zones++;
+        return;
+    }
+
+    int index = slot->zone_count++;
+    GLCProfilerZone *zone = &slot->zones[index];
+    zone->name = name;
+    zone->depth = profiler->depth;
+    zone->parent = profiler->depth ? profiler->stack[profiler->depth - 1] : -1;
+    zone->cpu_begin_ns = (unsigned long long)glc_time_ns();
+    zone->cpu_end_ns = zone->cpu_begin_ns;
+    profiler->gl.QueryCounter(slot->queries[2 * index], GL_TIMESTAMP);
+    profiler->stack[profiler->depth++] = index;
+}
+
+void glcProfilerEndZone(GLCProfiler *profiler)
+{
+    if(!profiler || profiler->current < 0) return;
+    if(profiler->ignored_depth) {
+        profiler->ignored_depth--;
+        return;
+    }
+    // The frame zone is only closed by glcProfilerEndFrame
+    if(profiler->depth <= 1) return;
+
+    glc_profiler_slot *slot = &profiler->slots[profiler->current];
+    int index = profiler->stack[--profiler->depth];
+    profiler->gl.QueryCounter(slot->queries[2 * index + 1], GL_TIMESTAMP);
+    slot->zones[index].cpu_end_ns = (unsigned long long)glc_time_ns();
+}
+
+void glcProfilerBeginFrame(GLCProfiler *profiler)
+{
+    if(!profiler || profiler->current >= 0) return;
+
+    int current = (int)(profiler->frame_index % GLC_PROFILER_LATENCY);
+    glc_profiler_slot *slot = &profiler->slots[current];
+    // The GPU is more than GLC_PROFILER_LATENCY frames behind, drop instead of stalling
+    if(slot->is_pending && !glc_profiler_resolve(profiler, slot)) profiler->dropped_frames++;
+
+    GLint64 gpu_now = 0;
+    profiler->gl.GetInteger64v(GL_TIMESTAMP, &gpu_now);
+    slot->gpu_offset_ns = (long long)gpu_now - glc_time_ns();
+    slot->index = profiler->frame_index;
+    slot->zone_count = 0;
+    slot->dropped_zones = 0;
+    slot->is_pending = 0;
+
+    profiler->current = current;
+    profiler->depth = 0;
+    profiler->ignored_depth = 0;
+    glcProfilerBeginZone(profiler, "frame");
+}
+
+void glcProfilerEndFrame(GLCProfiler *profiler)
+{
+    if(!profiler || profiler->current < 0) return;
+
+    // Close zones left open, then the frame itself
+    profiler->ignored_depth = 0;
+    while(profiler->depth > 1) glcProfilerEndZone(profiler);
+    glc_profiler_slot *slot = &profiler->slots[profiler->current];
+    profiler->gl.QueryCounter(slot->queries[1], GL_TIMESTAMP);
+    slot->zones[0].cpu_end_ns = (unsigned long long)glc_time_ns();
+    slot->is_pending = 1;
+    profiler->depth = 0;
+    profiler->current = -1;
+    profiler->frame_index++;
+
+    // Oldest first, newer frames can't be ready before older ones
+    for(int i = 0; i < GLC_PROFILER_LATENCY; ++i) {
+        glc_profiler_slot *pending = &profiler->slots[(profiler->frame_index + (unsigned)i) % GLC_PROFILER_LATENCY];
+        if(pending->is_pending && !glc_profiler_resolve(profiler, pending)) break;
+    }
+}
+
+int glcProfilerGetFrame(GLCProfiler *profiler, GLCProfilerFrame *frame)
+{
+    if(!(profiler && frame) || !profiler->result.is_valid) return 0;
+
+    const GLCProfilerZone *zones = profiler->result.zones;
+    frame->index = profiler->result.index;
+    frame->cpu_ns = zones[0].cpu_end_ns - zones[0].cpu_begin_ns;
+    frame->gpu_ns = zones[0].gpu_end_ns - zones[0].gpu_begin_ns;
+    frame->zones = zones;
+    frame->zone_count = profiler->result.zone_count;
+    frame->dropped_zones = profiler->result.dropped_zones;
+    frame->dropped_frames = profiler->dropped_frames;
+    return 1;
+}
+#endif // GLC_USE_PROFILER
+
+#if defined(GLC_USE_PRESENTER) || defined(GLC_USE_CAPTURE)
+#ifdef GLC_DISPLAY_WIN32
+typedef SRWLOCK glc_mutex;
+typedef CONDITION_VARIABLE glc_cond;
+typedef HANDLE glc_thread;
+#define glc_mutex_init(mutex) InitializeSRWLock(mutex)
+#define glc_mutex_destroy(mutex) ((void)(mutex))
+#define glc_mutex_lock(mutex) AcquireSRWLockExclusive(mutex)
+#define glc_mutex_unlock(mutex) ReleaseSRWLockExclusive(mutex)
+#define glc_cond_init(cond) InitializeConditionVariable(cond)
+#define glc_cond_destroy(cond) ((void)(cond))
+#define glc_cond_wait(cond, mutex) SleepConditionVariableSRW((cond), (mutex), INFINITE, 0)
+#define glc_cond_broadcast(cond) WakeAllConditionVariable(cond)
+#else
+typedef pthread_mutex_t glc_mutex;
+typedef pthread_cond_t glc_cond;
+typedef pthread_t glc_thread;
+#define glc_mutex_init(mutex) pthread_mutex_init((mutex), NULL)
+#define glc_mutex_destroy(mutex) pthread_mutex_destroy(mutex)
+#define glc_mutex_lock(mutex) pthread_mutex_lock(mutex)
+#define glc_mutex_unlock(mutex) pthread_mutex_unlock(mutex)
+#define glc_cond_init(cond) pthread_cond_init((cond), NULL)
+#define glc_cond_destroy(cond) pthread_cond_destroy(cond)
+#define glc_cond_wait(cond, mutex) pthread_cond_wait((cond), (mutex))
+#define glc_cond_broadcast(cond) pthread_cond_broadcast(cond)
+#endif
+#endif
+
+#ifdef GLC_USE_PRESENTER
+typedef struct glc_presenter_frame {
+    // Shared between both contexts
+    GLuint color;
+    // Only used by the render context
+    GLuint framebuffer;
+    GLuint depth_stencil;
+    // Read framebuffer of the present context, framebuffers aren't shared
+    GLuint present_framebuffer;
+    int width, height;
+    // Size the present framebuffer was attached at
+    int present_width, present_height;
+    // Rendering finished, waited on by the present context before the blit
+    GLCFence rendered;
+    // Blit finished, waited on by the render context before reusing the frame
+    GLCFence presented;
+} glc_presenter_frame;
+
+struct GLCPresenter {
+    GLCBackend *backend;
+    GLCContext *window_context;
+    GLCContext *context;
+    glc_presenter_frame *frames;
+    int frame_count;
+    int width, height;
+    // Frame being rendered, the next to present and how many are queued
+    int write_index, read_index, queued;
+    char is_rendering;
+    char is_running;
+    char has_thread;
+    glc_mutex mutex;
+    // Signaled when a frame is queued and when a queued frame is presented
+    glc_cond queued_changed;
+    glc_thread thread;
+    struct {
+        PFNGLGENFRAMEBUFFERSPROC GenFramebuffers;
+        PFNGLDELETEFRAMEBUFFERSPROC DeleteFramebuffers;
+        PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
+        PFNGLFRAMEBUFFERRENDERBUFFERPROC FramebufferRenderbuffer;
+        PFNGLGENRENDERBUFFERSPROC GenRenderbuffers;
+        PFNGLDELETERENDERBUFFERSPROC DeleteRenderbuffers;
+        PFNGLBINDRENDERBUFFERPROC BindRenderbuffer;
+        PFNGLRENDERBUFFERSTORAGEPROC RenderbufferStorage;
+        PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer;
+    } gl;
+};
+
+static void glc_presenter_present(GLCPresenter *presenter, glc_presenter_frame *frame)
+{
+    GLCBackend *backend = presenter->backend;
+
+    // The GPU waits for the render context, the present thread doesn't block
+    glcWaitFence(backend, frame->rendered);
+    glcDestroyFence(backend, frame->rendered);
+    frame->rendered = NULL;
+
+    if(!frame->present_framebuffer) presenter->gl.GenFramebuffers(1, &frame->present_framebuffer);
+    presenter->gl.BindFramebuffer(GL_READ_FRAMEBUFFER, frame->present_framebuffer);
+    if(frame->present_width != frame->width || frame->present_height != frame->height) {
+        presenter->gl.FramebufferRenderbuffer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, frame->color);
+        frame->present_width = frame->width;
+        frame->present_height = frame->height;
+    }
+    presenter->gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    presenter->gl.BlitFramebuffer(0, 0, frame->width, frame->height, 0, 0, frame->width, frame->height,
+            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    frame->presented = glcCreateFence(backend);
+
+    glcSwapBuffer(backend, presenter->window_context);
+}
+
+#ifdef GLC_DISPLAY_WIN32
+static DWORD WINAPI glc_presenter_thread(LPVOID data)
+#else
+static void *glc_presenter_thread(void *data)
+#endif
+{
+    GLCPresenter *presenter = (GLCPresenter *)data;
+
+    glcMakeContextCurrent(presenter->backend, presenter->window_context);
+    if(glcGetCurrentContext() != presenter->window_context) {
+        GLC_LOG_MESSAGE("Present thread failed to bind the window context");
+        glc_mutex_lock(&presenter->mutex);
+        presenter->is_running = 0;
+        glc_cond_broadcast(&presenter->queued_changed);
+        glc_mutex_unlock(&presenter->mutex);
+        return 0;
+    }
+
+    glc_mutex_lock(&presenter->mutex);
+    for(;;) {
+        while(presenter->is_running && !presenter->queued)
+            glc_cond_wait(&presenter->queued_changed, &presenter->mutex);
+        if(!presenter->is_running) break;
+        glc_presenter_frame *frame = &presenter->frames[presenter->read_index];
+        glc_mutex_unlock(&presenter->mutex);
+
+        glc_presenter_present(presenter, frame);
+
+        glc_mutex_lock(&presenter->mutex);
+        presenter->read_index = (presenter->read_index + 1) % presenter->frame_count;
+        presenter->queued--;
+        glc_cond_broadcast(&presenter->queued_changed);
+    }
+    glc_mutex_unlock(&presenter->mutex);
+
+    for(int i = 0; i < presenter->frame_count; ++i) {
+        if(presenter->frames[i].present_framebuffer)
+            presenter->gl.DeleteFramebuffers(1, &presenter->frames[i].present_framebuffer);
+    }
+    glcMakeContextCurrent(presenter->backend, NULL);
+    return 0;
+}
+
+// Window surfaces are created from the backend config, query it instead of binding window_context
+static int glc_presenter_sample_buffers(GLCBackend *backend) {
+#if defined(GLC_BACKEND_GLX)
+    int sample_buffers = 0;
+    glXGetFBConfigAttrib(backend->x11.display, backend->glx.fbconfig, GLX_SAMPLE_BUFFERS, &sample_buffers);
+    return sample_buffers;
+#elif defined(GLC_BACKEND_EGL)
+    EGLint sample_buffers = 0;
+    eglGetConfigAttrib(backend->egl.display, backend->egl.config, EGL_SAMPLE_BUFFERS, &sample_buffers);
+    return (int)sample_buffers;
+#else
+    (void)backend;
+    return 0;
+#endif
+}
+
+GLCPresenter *glcCreatePresenter(GLCBackend *backend, GLCContext *window_context,
+        const GLCContextConfig *config, int width, int height, int max_frames_in_flight)
+{
+    if(!backend || !window_context || !config || width <= 0 || height <= 0 || max_frames_in_flight <= 0) {
+        GLC_LOG_MESSAGE("Failed to create presenter due to invalid function glcCreatePresenter arguments");
+        return NULL;
+    }
+
+    GLCPresenter *result = (GLCPresenter *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCPresenter at glcCreatePresenter()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+    result->backend = backend;
+    result->window_context = window_context;
+    result->width = width;
+    result->height = height;
+    result->frame_count = max_frames_in_flight;
+    glc_mutex_init(&result->mutex);
+    glc_cond_init(&result->queued_changed);
+
+    result->gl.GenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)glcGetProcAddress(backend, "glGenFramebuffers");
+    result->gl.DeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)glcGetProcAddress(backend, "glDeleteFramebuffers");
+    result->gl.BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)glcGetProcAddress(backend, "glBindFramebuffer");
+    result->gl.FramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)glcGetProcAddress(backend, "glFramebufferRenderbuffer");
+    result->gl.GenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)glcGetProcAddress(backend, "glGenRenderbuffers");
+    result->gl.DeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)glcGetProcAddress(backend, "glDeleteRenderbuffers");
+    result->gl.BindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)glcGetProcAddress(backend, "glBindRenderbuffer");
+    result->gl.RenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)glcGetProcAddress(backend, "glRenderbufferStorage");
+    result->gl.BlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)glcGetProcAddress(backend, "glBlitFramebuffer");
+    if(!(result->gl.GenFramebuffers && result->gl.DeleteFramebuffers && result->gl.BindFramebuffer &&
+            result->gl.FramebufferRenderbuffer && result->gl.GenRenderbuffers && result->gl.DeleteRenderbuffers &&
+            result->gl.BindRenderbuffer && result->gl.RenderbufferStorage && result->gl.BlitFramebuffer)) {
+        GLC_LOG_MESSAGE("Framebuffer object functions are not available");
+        glcDestroyPresenter(result);
+        return NULL;
+    }
+
+    // Frames are single sampled, blitting them into a multisampled window is GL_INVALID_OPERATION
+    if(glc_presenter_sample_buffers(backend) > 0) {
+        GLC_LOG_MESSAGE("The presenter needs a single sampled window framebuffer config");
+        glcDestroyPresenter(result);
+        return NULL;
+    }
+
+    result->frames = (glc_presenter_frame *)GLC_MALLOC(sizeof(glc_presenter_frame) * (size_t)max_frames_in_flight);
+    if(!result->frames) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for presenter frames at glcCreatePresenter()");
+        glcDestroyPresenter(result);
+        return NULL;
+    }
+    memset(result->frames, 0, sizeof(glc_presenter_frame) * (size_t)max_frames_in_flight);
+
+    // The window surface can only be current on the present thread
+    GLCContextConfig render_config = *config;
+    render_config.share_with = window_context;
+    result->context = glcCreateWorkerContext(backend, &render_config);
+    if(!result->context) {
+        GLC_LOG_MESSAGE("Failed to create the presenter render context");
+        glcDestroyPresenter(result);
+        return NULL;
+    }
+    glcMakeContextCurrent(backend, result->context);
+
+    result->is_running = 1;
+#ifdef GLC_DISPLAY_WIN32
+    result->thread = CreateThread(NULL, 0, glc_presenter_thread, result, 0, NULL);
+    result->has_thread = result->thread != NULL;
+#else
+    result->has_thread = pthread_create(&result->thread, NULL, glc_presenter_thread, result) == 0;
+#endif
+    if(!result->has_thread) {
+        GLC_LOG_MESSAGE("Failed to start the present thread");
+        glcDestroyPresenter(result);
+        return NULL;
+    }
+    return result;
+}
+
+void glcDestroyPresenter(GLCPresenter *presenter)
+{
+    if(!presenter) return;
+
+    if(presenter->has_thread) {
+        glc_mutex_lock(&presenter->mutex);
+        presenter->is_running = 0;
+        glc_cond_broadcast(&presenter->queued_changed);
+        glc_mutex_unlock(&presenter->mutex);
+#ifdef GLC_DISPLAY_WIN32
+        WaitForSingleObject(presenter->thread, INFINITE);
+        CloseHandle(presenter->thread);
+#else
+        pthread_join(presenter->thread, NULL);
+#endif
+    }
+    glc_cond_destroy(&presenter->queued_changed);
+    glc_mutex_destroy(&presenter->mutex);
+
+    if(presenter->context) {
+        glcMakeContextCurrent(presenter->backend, presenter->context);
+        for(int i = 0; i < presenter->frame_count; ++i) {
+            glc_presenter_frame *frame = &presenter->frames[i];
+            if(frame->rendered) glcDestroyFence(presenter->backend, frame->rendered);
+            if(frame->presented) glcDestroyFence(presenter->backend, frame->presented);
+            if(frame->framebuffer) presenter->gl.DeleteFramebuffers(1, &frame->framebuffer);
+            if(frame->color) presenter->gl.DeleteRenderbuffers(1, &frame->color);
+            if(frame->depth_stencil) presenter->gl.DeleteRenderbuffers(1, &frame->depth_stencil);
+        }
+        glcDestroyContext(presenter->backend, presenter->context);
+    }
+    if(presenter->frames) GLC_FREE(presenter->frames);
+    GLC_FREE(presenter);
+}
+
+GLCContext *glcPresenterGetContext(GLCPresenter *presenter)
+{
+    return presenter ? presenter->context : NULL;
+}
+
+void glcPresenterResize(GLCPresenter *presenter, int width, int height)
+{
+    if(!presenter || width <= 0 || height <= 0) return;
+    presenter->width = width;
+    presenter->height = height;
+}
+
+unsigned int glcPresenterBeginFrame(GLCPresenter *presenter)
+{
+    if(!presenter || presenter->is_rendering) return 0;
+
+    glc_mutex_lock(&presenter->mutex);
+    while(presenter->is_running && presenter->queued == presenter->frame_count)
+        glc_cond_wait(&presenter->queued_changed, &presenter->mutex);
+    int is_running = presenter->is_running;
+    glc_mutex_unlock(&presenter->mutex);
+    if(!is_running) return 0;
+
+    glc_presenter_frame *frame = &presenter->frames[presenter->write_index];
+    if(frame->presented) {
+        // The last blit from this frame may still be reading it
+        glcWaitFence(presenter->backend, frame->presented);
+        glcDestroyFence(presenter->backend, frame->presented);
+        frame->presented = NULL;
+    }
+
+    if(!frame->framebuffer) {
+        presenter->gl.GenFramebuffers(1, &frame->framebuffer);
+        presenter->gl.GenRenderbuffers(1, &frame->color);
+        presenter->gl.GenRenderbuffers(1, &frame->depth_stencil);
+    }
+    presenter->gl.BindFramebuffer(GL_FRAMEBUFFER, frame->framebuffer);
+    if(frame->width != presenter->width || frame->height != presenter->height) {
+        presenter->gl.BindRenderbuffer(GL_RENDERBUFFER, frame->color);
+        presenter->gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, presenter->width, presenter->height);
+        presenter->gl.BindRenderbuffer(GL_RENDERBUFFER, frame->depth_stencil);
+        presenter->gl.RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, presenter->width, presenter->height);
+        presenter->gl.BindRenderbuffer(GL_RENDERBUFFER, 0);
+        presenter->gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, frame->color);
+        presenter->gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, frame->depth_stencil);
+        frame->width = presenter->width;
+        frame->height = presenter->height;
+    }
+    presenter->is_rendering = 1;
+    return frame->framebuffer;
+}
+
+void glcPresenterEndFrame(GLCPresenter *presenter)
+{
+    if(!presenter || !presenter->is_rendering) return;
+    presenter->is_rendering = 0;
+
+    glc_presenter_frame *frame = &presenter->frames[presenter->write_index];
+    frame->rendered = glcCreateFence(presenter->backend);
+    // The present context can only see the fence once it has been flushed
+    glFlush();
+
+    glc_mutex_lock(&presenter->mutex);
+    presenter->write_index = (presenter->write_index + 1) % presenter->frame_count;
+    presenter->queued++;
+    glc_cond_broadcast(&presenter->queued_changed);
+    glc_mutex_unlock(&presenter->mutex);
+}
+#endif // GLC_USE_PRESENTER
+
+#ifdef GLC_USE_CAPTURE
+typedef struct glc_capture_buffer {
+    GLuint buffer;
+    GLCFence fence;
+    // Persistent mapping read by the sink thread, NULL when mapped per frame
+    const unsigned char *pixels;
+    unsigned long long index;
+    // Readback queued, only touched by the render thread
+    char is_reading;
+    // Owned by the sink thread until it clears this, guarded by the mutex
+    char is_sinking;
+} glc_capture_buffer;
+
+struct GLCCapture {
+    GLCBackend *backend;
+    GLCContext *context;
+    int width, height;
+    size_t frame_size;
+    glc_capture_buffer *buffers;
+    int buffer_count;
+    unsigned long long frame_index;
+    GLCCaptureCallback callback;
+    void *user_data;
+    struct {
+        unsigned char *data;
+        size_t size;
+        unsigned long long max_frames;
+        // Frames written so far, only touched by whoever runs the sinks
+        unsigned long long frames;
+#ifdef GLC_DISPLAY_WIN32
+        HANDLE handle;
+        HANDLE mapping;
+#else
+        int fd;
+#endif
+    } file;
+    GLCCaptureStats stats;
+    // The sink thread takes buffers in ring order from sink_index on
+    char has_thread;
+    char is_running;
+    int sink_index, sink_queued;
+    glc_mutex mutex;
+    // Signaled when a buffer is handed to the sink thread and when it is done with one
+    glc_cond sink_changed;
+    glc_thread thread;
+    struct {
+        PFNGLGENBUFFERSPROC GenBuffers;
+        PFNGLDELETEBUFFERSPROC DeleteBuffers;
+        PFNGLBINDBUFFERPROC BindBuffer;
+        PFNGLBUFFERDATAPROC BufferData;
+        PFNGLBUFFERSTORAGEPROC BufferStorage;
+        PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+        PFNGLUNMAPBUFFERPROC UnmapBuffer;
+        PFNGLGETSTRINGIPROC GetStringi;
+    } gl;
+};
+
+// Runs the callback and the file sink on a frame, returns the time they took
+static unsigned long long glc_capture_sink(GLCCapture *capture, unsigned long long index, const unsigned char *pixels)
+{
+    long long begin = glc_time_ns();
+    if(capture->callback) {
+        GLCCaptureFrame frame;
+        frame.index = index;
+        frame.width = capture->width;
+        frame.height = capture->height;
+        frame.pixels = pixels;
+        capture->callback(&frame, capture->user_data);
+    }
+    if(capture->file.data && capture->file.frames < capture->file.max_frames) {
+        memcpy(capture->file.data + capture->file.frames * capture->frame_size, pixels, capture->frame_size);
+        capture->file.frames++;
+    }
+    return (unsigned long long)(glc_time_ns() - begin);
+}
+
+// Called with the mutex held when there is a sink thread
+static void glc_capture_sunk(GLCCapture *capture, unsigned long long sink_ns)
+{
+    capture->stats.delivered++;
+    capture->stats.file_frames = capture->file.frames;
+    capture->stats.total_sink_ns += sink_ns;
+}
+
+#ifdef GLC_DISPLAY_WIN32
+static DWORD WINAPI glc_capture_thread(LPVOID data)
+#else
+static void *glc_capture_thread(void *data)
+#endif
+{
+    GLCCapture *capture = (GLCCapture *)data;
+
+    glc_mutex_lock(&capture->mutex);
+    for(;;) {
+        while(capture->is_running && !capture->sink_queued)
+            glc_cond_wait(&capture->sink_changed, &capture->mutex);
+        // Frames handed over before the stop are still delivered
+        if(!capture->sink_queued) break;
+        glc_capture_buffer *buffer = &capture->buffers[capture->sink_index];
+        glc_mutex_unlock(&capture->mutex);
+
+        unsigned long long sink_ns = glc_capture_sink(capture, buffer->index, buffer->pixels);
+
+        glc_mutex_lock(&capture->mutex);
+        glc_capture_sunk(capture, sink_ns);
+        buffer->is_sinking = 0;
+        capture->sink_index = (capture->sink_index + 1) % capture->buffer_count;
+        capture->sink_queued--;
+        glc_cond_broadcast(&capture->sink_changed);
+    }
+    glc_mutex_unlock(&capture->mutex);
+    return 0;
+}
+
+// Waits until the sink thread went through every frame handed to it
+static void glc_capture_drain(GLCCapture *capture)
+{
+    if(!capture->has_thread) return;
+    glc_mutex_lock(&capture->mutex);
+    while(capture->sink_queued)
+        glc_cond_wait(&capture->sink_changed, &capture->mutex);
+    glc_mutex_unlock(&capture->mutex);
+}
+
+// Passes a finished readback on, buffers have to be handed over in ring order
+static void glc_capture_deliver(GLCCapture *capture, glc_capture_buffer *buffer)
+{
+    glcDestroyFence(capture->backend, buffer->fence);
+    buffer->fence = NULL;
+    buffer->is_reading = 0;
+
+    if(capture->has_thread) {
+        glc_mutex_lock(&capture->mutex);
+        buffer->is_sinking = 1;
+        capture->sink_queued++;
+        glc_cond_broadcast(&capture->sink_changed);
+        glc_mutex_unlock(&capture->mutex);
+        return;
+    }
+
+    if(buffer->pixels) {
+        glc_capture_sunk(capture, glc_capture_sink(capture, buffer->index, buffer->pixels));
+        return;
+    }
+    capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer);
+    const unsigned char *pixels = (const unsigned char *)capture->gl.MapBufferRange(GL_PIXEL_PACK_BUFFER,
+            0, (GLsizeiptr)capture->frame_size, GL_MAP_READ_BIT);
+    if(pixels) {
+        glc_capture_sunk(capture, glc_capture_sink(capture, buffer->index, pixels));
+        capture->gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        GLC_LOG_MESSAGE("Failed to map a capture buffer");
+    }
+    capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+static void glc_capture_close_file(GLCCapture *capture)
+{
+    if(!capture->file.data) return;
+#ifdef GLC_DISPLAY_WIN32
+    UnmapViewOfFile(capture->file.data);
+    CloseHandle(capture->file.mapping);
+    CloseHandle(capture->file.handle);
+#else
+    munmap(capture->file.data, capture->file.size);
+    close(capture->file.fd);
+#endif
+    capture->file.data = NULL;
+}
+
+// Immutable storage is what allows a buffer to stay mapped while the GPU writes it
+static int glc_capture_has_buffer_storage(GLCCapture *capture)
+{
+    if(!capture->gl.BufferStorage) return 0;
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if(major > 4 || (major == 4 && minor >= 4)) return 1;
+    if(!capture->gl.GetStringi) return 0;
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for(GLint i = 0; i < count; ++i) {
+        const char *name = (const char *)capture->gl.GetStringi(GL_EXTENSIONS, (GLuint)i);
+        if(name && strcmp(name, "GL_ARB_buffer_storage") == 0) return 1;
+    }
+    return 0;
+}
+
+GLCCapture *glcCreateCapture(GLCBackend *backend, GLCContext *context, int width, int height, int buffer_count)
+{
+    if(!backend || !context || width <= 0 || height <= 0 || buffer_count <= 0) {
+        GLC_LOG_MESSAGE("Failed to create capture due to invalid function glcCreateCapture arguments");
+        return NULL;
+    }
+
+    GLCCapture *result = (GLCCapture *)GLC_MALLOC(sizeof(*result));
+    if(!result) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for GLCCapture at glcCreateCapture()");
+        return NULL;
+    }
+    memset(result, 0, sizeof(*result));
+    result->backend = backend;
+    result->context = context;
+    result->width = width;
+    result->height = height;
+    result->frame_size = (size_t)width * (size_t)height * 4;
+    result->buffer_count = buffer_count;
+
+    result->gl.GenBuffers = (PFNGLGENBUFFERSPROC)glcGetProcAddress(backend, "glGenBuffers");
+    result->gl.DeleteBuffers = (PFNGLDELETEBUFFERSPROC)glcGetProcAddress(backend, "glDeleteBuffers");
+    result->gl.BindBuffer = (PFNGLBINDBUFFERPROC)glcGetProcAddress(backend, "glBindBuffer");
+    result->gl.BufferData = (PFNGLBUFFERDATAPROC)glcGetProcAddress(backend, "glBufferData");
+    result->gl.BufferStorage = (PFNGLBUFFERSTORAGEPROC)glcGetProcAddress(backend, "glBufferStorage");
+    result->gl.MapBufferRange = (PFNGLMAPBUFFERRANGEPROC)glcGetProcAddress(backend, "glMapBufferRange");
+    result->gl.UnmapBuffer = (PFNGLUNMAPBUFFERPROC)glcGetProcAddress(backend, "glUnmapBuffer");
+    result->gl.GetStringi = (PFNGLGETSTRINGIPROC)glcGetProcAddress(backend, "glGetStringi");
+    if(!(result->gl.GenBuffers && result->gl.DeleteBuffers && result->gl.BindBuffer &&
+            result->gl.BufferData && result->gl.MapBufferRange && result->gl.UnmapBuffer)) {
+        GLC_LOG_MESSAGE("Pixel buffer functions are not available");
+        GLC_FREE(result);
+        return NULL;
+    }
+
+    result->buffers = (glc_capture_buffer *)GLC_MALLOC(sizeof(glc_capture_buffer) * (size_t)buffer_count);
+    if(!result->buffers) {
+        GLC_LOG_MESSAGE("Failed to allocate memory for capture buffers at glcCreateCapture()");
+        GLC_FREE(result);
+        return NULL;
+    }
+    memset(result->buffers, 0, sizeof(glc_capture_buffer) * (size_t)buffer_count);
+    glc_mutex_init(&result->mutex);
+    glc_cond_init(&result->sink_changed);
+
+    // Coherent, so a signaled fence is all the sink thread needs before reading
+    const GLbitfield persistent = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    int is_persistent = glc_capture_has_buffer_storage(result);
+    for(int i = 0; i < buffer_count; ++i) {
+        glc_capture_buffer *buffer = &result->buffers[i];
+        result->gl.GenBuffers(1, &buffer->buffer);
+        result->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer);
+        if(is_persistent) {
+            result->gl.BufferStorage(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)result->frame_size, NULL, persistent);
+            buffer->pixels = (const unsigned char *)result->gl.MapBufferRange(GL_PIXEL_PACK_BUFFER,
+                    0, (GLsizeiptr)result->frame_size, persistent);
+        } else {
+            result->gl.BufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)result->frame_size, NULL, GL_STREAM_READ);
+        }
+        // Mapping per frame still works on storage meant for persistent mapping
+        if(is_persistent && !buffer->pixels) is_persistent = 0;
+    }
+    result->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if(is_persistent) {
+        result->is_running = 1;
+#ifdef GLC_DISPLAY_WIN32
+        result->thread = CreateThread(NULL, 0, glc_capture_thread, result, 0, NULL);
+        result->has_thread = result->thread != NULL;
+#else
+        result->has_thread = pthread_create(&result->thread, NULL, glc_capture_thread, result) == 0;
+#endif
+        if(!result->has_thread) GLC_LOG_MESSAGE("Failed to start the capture sink thread, sinks run in glcCaptureDeliver");
+    }
+    return result;
+}
+
+void glcDestroyCapture(GLCCapture *capture)
+{
+    if(!capture) return;
+
+    // Oldest first so frames reach the sinks in order
+    for(int i = 0; i < capture->buffer_count; ++i) {
+        glc_capture_buffer *buffer = &capture->buffers[(capture->frame_index + (unsigned)i) % (unsigned)capture->buffer_count];
+        if(!buffer->is_reading) continue;
+        glcClientWaitFence(capture->backend, buffer->fence, GL_TIMEOUT_IGNORED);
+        glc_capture_deliver(capture, buffer);
+    }
+    if(capture->has_thread) {
+        glc_mutex_lock(&capture->mutex);
+        capture->is_running = 0;
+        glc_cond_broadcast(&capture->sink_changed);
+        glc_mutex_unlock(&capture->mutex);
+#ifdef GLC_DISPLAY_WIN32
+        WaitForSingleObject(capture->thread, INFINITE);
+        CloseHandle(capture->thread);
+#else
+        pthread_join(capture->thread, NULL);
+#endif
+    }
+    glc_cond_destroy(&capture->sink_changed);
+    glc_mutex_destroy(&capture->mutex);
+
+    for(int i = 0; i < capture->buffer_count; ++i) {
+        if(capture->buffers[i].pixels) {
+            capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, capture->buffers[i].buffer);
+            capture->gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        capture->gl.DeleteBuffers(1, &capture->buffers[i].buffer);
+    }
+    capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glc_capture_close_file(capture);
+    GLC_FREE(capture->buffers);
+    GLC_FREE(capture);
+}
+
+void glcCaptureSetCallback(GLCCapture *capture, GLCCaptureCallback callback, void *user_data)
+{
+    if(!capture) return;
+    glc_capture_drain(capture);
+    capture->callback = callback;
+    capture->user_data = user_data;
+}
+
+int glcCaptureSetFile(GLCCapture *capture, const char *path, int max_frames)
+{
+    if(!capture || !path || max_frames <= 0) {
+        GLC_LOG_MESSAGE("Failed to set capture file due to invalid function glcCaptureSetFile arguments");
+        return 0;
+    }
+    glc_capture_drain(capture);
+    glc_capture_close_file(capture);
+    capture->file.frames = 0;
+    capture->stats.file_frames = 0;
+
+    // Sized up front so delivering a frame is a single copy
+    size_t size = capture->frame_size * (size_t)max_frames;
+#ifdef GLC_DISPLAY_WIN32
+    capture->file.handle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(capture->file.handle == INVALID_HANDLE_VALUE) {
+        GLC_LOG_MESSAGE("Failed to open the capture file");
+        return 0;
+    }
+    capture->file.mapping = CreateFileMappingA(capture->file.handle, NULL, PAGE_READWRITE,
+            (DWORD)((unsigned long long)size >> 32), (DWORD)size, NULL);
+    void *data = capture->file.mapping ? MapViewOfFile(capture->file.mapping, FILE_MAP_WRITE, 0, 0, size) : NULL;
+    if(!data) {
+        GLC_LOG_MESSAGE("Failed to map the capture file");
+        if(capture->file.mapping) CloseHandle(capture->file.mapping);
+        CloseHandle(capture->file.handle);
+        return 0;
+    }
+#else
+    capture->file.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(capture->file.fd < 0) {
+        GLC_LOG_MESSAGE("Failed to open the capture file");
+        return 0;
+    }
+    // Prefaulted where possible, page faults would otherwise cost more than the copy
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    void *data = ftruncate(capture->file.fd, (off_t)size) == 0 ?
+        mmap(NULL, size, PROT_READ | PROT_WRITE, flags, capture->file.fd, 0) : MAP_FAILED;
+    if(data == MAP_FAILED) {
+        GLC_LOG_MESSAGE("Failed to map the capture file");
+        close(capture->file.fd);
+        return 0;
+    }
+#endif
+    capture->file.data = (unsigned char *)data;
+    capture->file.size = size;
+    capture->file.max_frames = (unsigned long long)max_frames;
+    return 1;
+}
+
+void glcCaptureFrame(GLCCapture *capture)
+{
+    if(!capture) return;
+    long long begin = glc_time_ns();
+
+    glc_capture_buffer *buffer = &capture->buffers[capture->frame_index % (unsigned)capture->buffer_count];
+    if(buffer->is_reading) {
+        capture->stats.overruns++;
+        if(!glcClientWaitFence(capture->backend, buffer->fence, 0)) {
+            capture->stats.stalls++;
+            glcClientWaitFence(capture->backend, buffer->fence, GL_TIMEOUT_IGNORED);
+        }
+        glc_capture_deliver(capture, buffer);
+    }
+    if(capture->has_thread) {
+        glc_mutex_lock(&capture->mutex);
+        if(buffer->is_sinking) capture->stats.sink_stalls++;
+        while(buffer->is_sinking)
+            glc_cond_wait(&capture->sink_changed, &capture->mutex);
+        glc_mutex_unlock(&capture->mutex);
+    }
+
+    capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, buffer->buffer);
+    glReadPixels(0, 0, capture->width, capture->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    capture->gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    buffer->fence = glcCreateFence(capture->backend);
+    buffer->index = capture->frame_index;
+    buffer->is_reading = buffer->fence != NULL;
+    capture->frame_index++;
+    capture->stats.captured++;
+
+    capture->stats.last_cpu_ns = (unsigned long long)(glc_time_ns() - begin);
+    capture->stats.total_cpu_ns += capture->stats.last_cpu_ns;
+}
+
+int glcCaptureDeliver(GLCCapture *capture)
+{
+    if(!capture) return 0;
+    long long begin = glc_time_ns();
+
+    // Oldest first to keep the order, stop at the first readback still running
+    int delivered = 0;
+    for(int i = 0; i < capture->buffer_count; ++i) {
+        glc_capture_buffer *pending = &capture->buffers[(capture->frame_index + (unsigned)i) % (unsigned)capture->buffer_count];
+        if(!pending->is_reading) continue;
+        if(!glcClientWaitFence(capture->backend, pending->fence, 0)) break;
+        glc_capture_deliver(capture, pending);
+        delivered++;
+    }
+
+    capture->stats.last_deliver_ns = (unsigned long long)(glc_time_ns() - begin);
+    capture->stats.total_deliver_ns += capture->stats.last_deliver_ns;
+    return delivered;
+}
+
+void glcGetCaptureStats(GLCCapture *capture, GLCCaptureStats *stats)
+{
+    if(!(capture && stats)) return;
+    if(capture->has_thread) glc_mutex_lock(&capture->mutex);
+    *stats = capture->stats;
+    if(capture->has_thread) glc_mutex_unlock(&capture->mutex);
 }
+#endif // GLC_USE_CAPTURE
 
 #endif // GLC_IMPLEMENTATION
@@ -6,20 +6,56 @@
 #define SWL_LOG_MESSAGE(message) printf("%s\n", (message));
 #endif
 
-#ifndef SWL_MAXIMUM_WINDOW_CREATED
-#define SWL_MAXIMUM_WINDOW_CREATED 8
+#if !defined(SWL_MALLOC) && !defined(SWL_FREE)
+#include <stdlib.h>
+#define SWL_MALLOC malloc
+#define SWL_FREE free
 #endif
 
+#if !defined(SWL_MALLOC) || !defined(SWL_FREE)
+#error "Please define both SWL_MALLOC and SWL_FREE macros"
+#endif
+
+// Windows are allocated in blocks of this many, the pool grows on demand
+#ifndef SWL_WINDOW_POOL_BLOCK_SIZE
+#define SWL_WINDOW_POOL_BLOCK_SIZE 8
+#endif
+
+#ifndef SWL_WINDOW_TITLE_CAPACITY
+#define SWL_WINDOW_TITLE_CAPACITY 256
+#endif
+
+// Must be a power of two. The event queue is a lock-free ring with a single
+// producer and any number of consumers. Define SWL_EVENT_QUEUE_MULTI_PRODUCER
+// when more than one thread calls swl_push_event.
 #ifndef SWL_EVENT_QUEUE_CAPACITY
 #define SWL_EVENT_QUEUE_CAPACITY 256
 #endif
 
+#if (SWL_EVENT_QUEUE_CAPACITY & (SWL_EVENT_QUEUE_CAPACITY - 1)) != 0
+#error "SWL_EVENT_QUEUE_CAPACITY must be a power of two"
+#endif
+
+// Number of events the platform pump collects before pushing them in one batch
+#ifndef SWL_EVENT_BATCH_CAPACITY
+#define SWL_EVENT_BATCH_CAPACITY 64
+#endif
+
+#ifndef SWL_CACHE_LINE_SIZE
+#define SWL_CACHE_LINE_SIZE 64
+#endif
+
 #ifdef _WIN32
 #define SWL_DISPLAY_WIN32
 #endif
 
+// Define SWL_USE_XINPUT2 to read unaccelerated mouse motion from XInput2 raw
+// events on the Xlib backend, link with Xi
+// Define SWL_DISPLAY_XCB to use the XCB backend instead of Xlib, link with xcb
+// Define SWL_USE_XSHM to share swl_framebuffer pixels with the X server through
+// MIT-SHM on the Xlib backend, link with Xext
 #ifdef __linux__
-#if !defined(SWL_DISPLAY_X11) || !defined(SWL_DISPLAY_WAYLAND)
+#if !defined(SWL_DISPLAY_X11) && !defined(SWL_DISPLAY_XCB) && !defined(SWL_DISPLAY_WAYLAND)
 #define SWL_DISPLAY_X11
 #endif
 #endif
@@ -31,6 +67,7 @@ typedef int swl_bool;
 
 typedef unsigned char swl_uint8;
 typedef unsigned int swl_uint32;
+typedef unsigned long long swl_uint64;
 
 typedef struct swl_window swl_window;
 
@@ -49,6 +86,13 @@ Display *swl_x11_get_display(void);
 Window swl_x11_get_window(swl_window *window);
 #endif
 
+#ifdef SWL_DISPLAY_XCB
+typedef struct xcb_connection_t xcb_connection_t;
+
+xcb_connection_t *swl_xcb_get_connection(void);
+swl_uint32 swl_xcb_get_window(swl_window *window);
+#endif
+
 typedef struct swl_event {
     int type;
     union {
@@ -57,14 +101,61 @@ typedef struct swl_event {
             int x, y;
             unsigned int width, height;
         } window;
+        // time is a monotonic timestamp in nanoseconds, taken from the server when available
         struct {
             int keycode;
             int mods;
             int scancode;
+            swl_uint64 time;
         } key;
+        struct {
+            swl_window *window;
+            int x, y;
+            int button;
+            swl_uint64 time;
+        } mouse;
     };
 } swl_event;
 
+// Counters of the last swl_poll_window_events call
+typedef struct swl_poll_stats {
+    swl_uint32 events_read;
+    swl_uint32 events_pushed;
+    swl_uint32 motion_coalesced;
+    swl_uint32 resize_coalesced;
+    swl_uint32 expose_coalesced;
+    swl_uint32 raw_motion_accumulated;
+    // Estimates, not measured syscalls: calls into Xlib/XCB that flush the
+    // output buffer and calls that may read the socket. The libraries skip
+    // the write when nothing is buffered and the read when nothing arrived.
+    swl_uint32 estimated_flushes;
+    swl_uint32 estimated_reads;
+} swl_poll_stats;
+
+typedef enum {
+    // Flush and read the connection once, then drain what is already queued
+    SWL_POLL_MODE_BULK = 0,
+    // Flush and read the connection before every event
+    SWL_POLL_MODE_PENDING,
+} swl_poll_mode;
+
+// Zero-copy view into the event queue, the events are split in at most two
+// contiguous runs when the view wraps around the end of the ring
+typedef struct swl_event_span {
+    const swl_event *first;
+    swl_uint32 first_count;
+    const swl_event *second;
+    swl_uint32 second_count;
+    swl_uint32 start;
+} swl_event_span;
+
+typedef struct swl_rect {
+    int x, y;
+    swl_uint32 width, height;
+} swl_rect;
+
+typedef struct swl_framebuffer swl_framebuffer;
+
 typedef struct swl_window_config {
     const char *title;
     swl_uint32 width, height;
@@ -75,20 +166,75 @@ swl_bool swl_init(void);
 void swl_deinit(void);
 swl_bool swl_push_event(swl_event event);
 swl_bool swl_shift_event(swl_event *event);
+// Batch variants return the number of events actually pushed/shifted
+swl_uint32 swl_push_events(const swl_event *events, swl_uint32 count);
+swl_uint32 swl_shift_events(swl_event *events, swl_uint32 count);
+// Reserve up to count events without copying them out. Every successful peek
+// must be followed by swl_release_events once the events have been consumed.
+// Until then the same thread can't shift or peek again: those calls log and
+// return 0 instead of waiting on a span that only it can release.
+swl_uint32 swl_peek_events(swl_event_span *span, swl_uint32 count);
+void swl_release_events(const swl_event_span *span);
+// Number of events dropped because the queue was full
+swl_uint32 swl_get_event_overflow_count(void);
 
 swl_window *swl_create_window(const swl_window_config *config);
+// swl_create_window on a given X11 visual, e.g. the one an OpenGL framebuffer
+// config needs so presents don't have to be converted. A visual_id of 0 keeps
+// the default visual, a depth of 0 takes the depth of the visual. Other
+// platforms ignore both.
+swl_window *swl_create_window_with_visual(const swl_window_config *config, swl_uint32 visual_id, swl_uint32 depth);
 void swl_destroy_window(swl_window *window);
 
 void swl_set_window_title(swl_window *window, const char *title);
 void swl_set_window_visible(swl_window *window, swl_bool is_visible);
 void swl_set_window_resizable(swl_window *window, swl_bool is_resizable);
+// Property setters only record the new state. Changes are sent together at the
+// next poll, or right away with swl_commit_window.
+void swl_commit_window(swl_window *window);
 void swl_poll_window_events(void);
+// When enabled the pump folds consecutive mouse motion, keeps only the latest
+// size per window and merges expose series into a single rectangle
+void swl_set_event_coalescing(swl_bool is_enabled);
+void swl_get_poll_stats(swl_poll_stats *stats);
+void swl_set_poll_mode(swl_poll_mode mode);
+// Block until at least one platform event arrives (or the timeout expires),
+// then process it like swl_poll_window_events
+void swl_wait_events(void);
+void swl_wait_events_timeout(swl_uint64 timeout_ns);
+// Wake up a thread blocked in swl_wait_events, safe to call from any thread
+void swl_post_empty_event(void);
+// Unaccelerated mouse motion accumulated since the previous call, and the time
+// of the latest raw sample. Returns SWL_FALSE (and a zero delta) when raw input
+// is not available. Call it from the thread that polls events.
+swl_bool swl_get_raw_mouse_delta(double *dx, double *dy, swl_uint64 *time);
+
+// CPU rendered pixels shown at the top left of a window, destroy it before the
+// window. Pixels are 32-bit 0x00RRGGBB and rows are stride bytes apart. On X11
+// the window needs a depth 24 visual, an ARGB window would read the unused byte
+// as alpha and show through.
+swl_framebuffer *swl_create_framebuffer(swl_window *window, swl_uint32 width, swl_uint32 height);
+void swl_destroy_framebuffer(swl_framebuffer *framebuffer);
+// Pixels to draw the next frame into, they already hold the last presented
+// frame. A shared buffer is only handed out once the server finished reading
+// it: with should_wait events are pumped until then, otherwise NULL is returned.
+void *swl_acquire_framebuffer(swl_framebuffer *framebuffer, swl_uint32 *stride, swl_bool should_wait);
+// Show the acquired pixels, limited to the rectangles when rect_count is not 0
+void swl_present_framebuffer(swl_framebuffer *framebuffer, const swl_rect *rects, swl_uint32 rect_count);
+// SWL_TRUE when the server reads the pixels through shared memory instead of
+// receiving a copy with every present
+swl_bool swl_is_framebuffer_shared(const swl_framebuffer *framebuffer);
 
 typedef enum {
     SWL_EVENT_UNKNOWN = 0,
     SWL_EVENT_WINDOW_CLOSED,
     SWL_EVENT_KEY_PRESSED,
     SWL_EVENT_KEY_RELEASED,
+    SWL_EVENT_WINDOW_RESIZED,
+    SWL_EVENT_WINDOW_EXPOSED,
+    SWL_EVENT_MOUSE_MOVED,
+    SWL_EVENT_MOUSE_BUTTON_PRESSED,
+    SWL_EVENT_MOUSE_BUTTON_RELEASED,
 } rn_event_type;
 
 enum swl_keycode {
@@ -220,6 +366,15 @@ enum swl_keycode {
     SWL_KEY_LAST = SWL_KEY_MENU,
 };
 
+enum swl_mod {
+    SWL_MOD_SHIFT     = 1 << 0,
+    SWL_MOD_CONTROL   = 1 << 1,
+    SWL_MOD_ALT       = 1 << 2,
+    SWL_MOD_SUPER     = 1 << 3,
+    SWL_MOD_CAPS_LOCK = 1 << 4,
+    SWL_MOD_NUM_LOCK  = 1 << 5,
+};
+
 #endif // SWL_H_
 
 #ifdef SWL_IMPLEMENTATION
@@ -230,392 +385,2246 @@ typedef struct swl_window__platform {
     HWND hwnd;
 } swl_window__platform;
 
+typedef struct swl_framebuffer__platform {
+    BITMAPINFO info;
+} swl_framebuffer__platform;
+
 typedef struct swl_application__platform {
     HINSTANCE inst;
     WNDCLASS wcls;
     const char *wcls_name;
     ATOM wcls_atom;
+    DWORD thread_id;
 } swl_application__platform;
 #endif
 
+#if defined(SWL_DISPLAY_X11) || defined(SWL_DISPLAY_XCB)
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+#include <X11/X.h>
+#include <X11/keysym.h>
+
+// Colormaps are created once per visual and shared by every window using it
+typedef struct swl_colormap__x11 {
+    swl_uint32 visual_id;
+    swl_uint32 colormap;
+} swl_colormap__x11;
+#endif
+
 #ifdef SWL_DISPLAY_X11
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <X11/XKBlib.h>
+#ifdef SWL_USE_XINPUT2
+#include <X11/extensions/XInput2.h>
+#endif
+#ifdef SWL_USE_XSHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <X11/extensions/XShm.h>
+#endif
 typedef struct swl_window__platform{
     Window window;
+    XSizeHints size_hints;
+    Visual *visual;
+    int depth;
 } swl_window__platform;
 
+typedef struct swl_framebuffer__platform {
+    GC gc;
+    XImage *images[2];
+#ifdef SWL_USE_XSHM
+    XShmSegmentInfo shm[2];
+#endif
+} swl_framebuffer__platform;
+
 typedef struct swl_application__platform {
     Display *display;
-    Colormap colormap;
+    swl_colormap__x11 *colormaps;
+    swl_uint32 colormap_count, colormap_capacity;
     Atom wm_delete_window;
+    int wakeup_fd;
+    swl_bool xkb_available;
+    swl_uint32 server_time;
+    swl_uint64 server_time_high;
+#ifdef SWL_USE_XINPUT2
+    int xi_opcode;
+    // Raw events are not tied to a window, motion only counts while one of ours has focus
+    swl_window *focused_window;
+#endif
+#ifdef SWL_USE_XSHM
+    swl_bool shm_available;
+    int shm_completion_type;
+#endif
+
+    int keycodes[256];
+    int scancodes[SWL_KEY_LAST + 1];
+} swl_application__platform;
+#endif
+
+#ifdef SWL_DISPLAY_XCB
+#include <xcb/xcb.h>
+#include <stdlib.h>
+typedef struct swl_window__platform {
+    xcb_window_t window;
+    swl_uint8 depth;
+} swl_window__platform;
+
+typedef struct swl_framebuffer__platform {
+    xcb_gcontext_t gc;
+} swl_framebuffer__platform;
+
+enum {
+    SWL_XCB_ATOM_WM_PROTOCOLS,
+    SWL_XCB_ATOM_WM_DELETE_WINDOW,
+    SWL_XCB_ATOM_NET_WM_NAME,
+    SWL_XCB_ATOM_UTF8_STRING,
+    SWL_XCB_ATOM_COUNT
+};
+
+typedef struct swl_application__platform {
+    xcb_connection_t *connection;
+    xcb_screen_t *screen;
+    xcb_atom_t atoms[SWL_XCB_ATOM_COUNT];
+    swl_colormap__x11 *colormaps;
+    swl_uint32 colormap_count, colormap_capacity;
+    int wakeup_fd;
+
+    // Event taken off the queue while checking for queued events before a wait
+    xcb_generic_event_t *pending_event;
+    swl_uint32 server_time;
+    swl_uint64 server_time_high;
 
     int keycodes[256];
     int scancodes[SWL_KEY_LAST + 1];
 } swl_application__platform;
 #endif
 
+enum {
+    SWL_WINDOW_DIRTY_TITLE     = 1 << 0,
+    SWL_WINDOW_DIRTY_VISIBLE   = 1 << 1,
+    SWL_WINDOW_DIRTY_RESIZABLE = 1 << 2,
+};
+
 typedef struct swl_window {
-    const char *title;
+    char title[SWL_WINDOW_TITLE_CAPACITY];
     swl_uint32 width, height;
     swl_bool is_visible, is_resizable;
+    swl_uint32 dirty;
+
+    // Union of the expose series currently being coalesced
+    swl_bool expose_pending;
+    int expose_x0, expose_y0, expose_x1, expose_y1;
 
     swl_window__platform platform;
     swl_bool initialized;
+    struct swl_window *next_free;
 } swl_window;
 
+// A single buffer is enough when every present copies the pixels
+#define SWL_FRAMEBUFFER_BUFFER_COUNT 2
+
+typedef struct swl_framebuffer_buffer {
+    void *pixels;
+    // Set from a shared present until the server reports it is done reading
+    swl_bool is_busy;
+    // Area presented from the other buffer since this one was shown, copied in on acquire
+    swl_bool has_damage;
+    int damage_x0, damage_y0, damage_x1, damage_y1;
+} swl_framebuffer_buffer;
+
+struct swl_framebuffer {
+    swl_window *window;
+    swl_uint32 width, height, stride;
+    swl_bool is_shared;
+    swl_uint32 buffer_count;
+    swl_framebuffer_buffer buffers[SWL_FRAMEBUFFER_BUFFER_COUNT];
+    // Buffer handed out by swl_acquire_framebuffer, -1 when none
+    int acquired;
+    // Last presented buffer
+    int front;
+
+    swl_framebuffer__platform platform;
+    struct swl_framebuffer *next;
+};
+
+typedef struct swl_window_block {
+    struct swl_window_block *next;
+    swl_window windows[SWL_WINDOW_POOL_BLOCK_SIZE];
+} swl_window_block;
+
+// Open addressing table from native window handle to swl_window, key 0 marks an empty slot
+typedef struct swl_window_map_entry {
+    swl_uint64 key;
+    swl_window *window;
+} swl_window_map_entry;
+
+#define SWL_EVENT_QUEUE_MASK (SWL_EVENT_QUEUE_CAPACITY - 1)
+
+// head is the next index to be reserved, tail is the next index to be published.
+// Indices run freely and are masked on access.
+typedef struct swl_event_queue_cursor {
+    volatile swl_uint32 head, tail;
+} swl_event_queue_cursor;
+
 typedef struct swl_application {
     swl_bool initialized;
-    swl_window windows[SWL_MAXIMUM_WINDOW_CREATED];
+
+    struct {
+        swl_window_block *blocks;
+        swl_window *free_list;
+    } window_pool;
+
+    struct {
+        swl_window_map_entry *entries;
+        swl_uint32 capacity, count;
+    } window_map;
 
     struct {
         swl_event items[SWL_EVENT_QUEUE_CAPACITY];
-        swl_uint32 head, tail;
-        swl_bool carry;
+        swl_uint8 pad0[SWL_CACHE_LINE_SIZE];
+        swl_event_queue_cursor producer;
+        swl_uint8 pad1[SWL_CACHE_LINE_SIZE - sizeof(swl_event_queue_cursor)];
+        swl_event_queue_cursor consumer;
+        swl_uint8 pad2[SWL_CACHE_LINE_SIZE - sizeof(swl_event_queue_cursor)];
+        volatile swl_uint32 overflow_count;
     } event_queue;
 
+    swl_bool coalesce_events;
+    swl_poll_mode poll_mode;
+    swl_poll_stats poll_stats;
+
+    struct {
+        swl_bool is_available;
+        double dx, dy;
+        swl_uint64 time;
+    } raw_motion;
+
+    // Live framebuffers, searched when the server releases a shared buffer
+    swl_framebuffer *framebuffers;
+
     swl_application__platform platform;
 } swl_application;
 
 static swl_application APP = {0};
 
-static void *swl_memset(void *dst, const int val, swl_uint32 size)
+#if defined(_MSC_VER)
+#include <intrin.h>
+static swl_uint32 swl_atomic_load(volatile swl_uint32 *ptr)
 {
-    for(swl_uint32 i = 0; i < size; ++i)
-        ((swl_uint8 *)dst)[i] = (const swl_uint8)val;
-    return dst;
+    swl_uint32 value = *ptr;
+    _ReadWriteBarrier();
+    return value;
 }
 
-#ifdef SWL_DISPLAY_WIN32
-LRESULT CALLBACK _swl_win32_window_proc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-static swl_bool swl_init__platform(void)
+static void swl_atomic_store(volatile swl_uint32 *ptr, swl_uint32 value)
 {
-    APP.platform.wcls_name = "SimpleWindowLibraryWi32Window";
-    APP.platform.inst = (HINSTANCE)GetModuleHandle(SWL_NULL);
-    if(!APP.platform.inst) {
-        SWL_LOG_MESSAGE("Failed to get the module handle");
-        return SWL_FALSE;
-    }
-
-    swl_memset(&APP.platform.wcls, 0, sizeof(APP.platform.wcls));
-    APP.platform.wcls.style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
-    APP.platform.wcls.lpfnWndProc = _swl_win32_window_proc;
-    APP.platform.wcls.hInstance = APP.platform.inst;
-    APP.platform.wcls.hIcon = LoadIcon(APP.platform.inst, IDI_APPLICATION);
-    APP.platform.wcls.hCursor = LoadCursor(SWL_NULL, IDC_ARROW);
-    APP.platform.wcls.hbrBackground = (HBRUSH)COLOR_WINDOW;
-    APP.platform.wcls.lpszClassName = APP.platform.wcls_name;
-
-    APP.platform.wcls_atom = RegisterClass(&APP.platform.wcls);
-    if(!APP.platform.wcls_atom) {
-        SWL_LOG_MESSAGE("Failed to register window class");
-        return SWL_FALSE;
-    }
-
-    return SWL_TRUE;
+    _ReadWriteBarrier();
+    *ptr = value;
 }
 
-static void swl_deinit__platform(void)
+static swl_bool swl_atomic_cas(volatile swl_uint32 *ptr, swl_uint32 *expected, swl_uint32 desired)
 {
-
+    swl_uint32 previous = (swl_uint32)_InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)*expected);
+    if(previous == *expected) return SWL_TRUE;
+    *expected = previous;
+    return SWL_FALSE;
 }
 
-static swl_bool swl_create_window__platform(swl_window *window, const swl_window_config *config)
+static void swl_atomic_add(volatile swl_uint32 *ptr, swl_uint32 value)
 {
-    RECT content;
-    swl_memset(&content, 0, sizeof(content));
-    content.right = config->width;
-    content.bottom = config->height;
-
-    HWND hwnd = CreateWindowEx(
-            WS_EX_APPWINDOW,
-            MAKEINTATOM(APP.platform.wcls_atom),
-            config->title,
-            WS_OVERLAPPEDWINDOW,
-            CW_USEDEFAULT,
-            CW_USEDEFAULT,
-            content.right - content.left,
-            content.bottom - content.top,
-            SWL_NULL,
-            SWL_NULL,
-            APP.platform.inst,
-            SWL_NULL);
-
-    if(!hwnd) {
-        SWL_LOG_MESSAGE("Failed to create win32 window");
-        return SWL_FALSE;
-    }
-
-    window->platform.hwnd = hwnd;
-
-    return SWL_TRUE;
+    _InterlockedExchangeAdd((volatile long *)ptr, (long)value);
 }
 
-static void swl_destroy_window__platform(swl_window *window)
+#define swl_cpu_relax() _mm_pause()
+#define SWL_THREAD_LOCAL __declspec(thread)
+#else
+static swl_uint32 swl_atomic_load(volatile swl_uint32 *ptr)
 {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
 }
 
-void swl_set_window_title(swl_window *window, const char *title)
+static void swl_atomic_store(volatile swl_uint32 *ptr, swl_uint32 value)
 {
-    if(!window) {
-        SWL_LOG_MESSAGE("Please provide a valid window to swl_set_window_title()");
-        return;
-    }
-    SetWindowText(window->platform.hwnd, title);
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
 }
 
-void swl_set_window_visible(swl_window *window, swl_bool is_visible)
+static swl_bool swl_atomic_cas(volatile swl_uint32 *ptr, swl_uint32 *expected, swl_uint32 desired)
 {
-    if(!window) {
-        SWL_LOG_MESSAGE("Please provide a valid window to swl_set_window_visible()");
-        return;
-    }
-    swl_uint32 show_window_command_flag = is_visible ? SW_SHOWNA : SW_HIDE;
-    ShowWindow(window->platform.hwnd, show_window_command_flag);
+    return __atomic_compare_exchange_n(ptr, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
 }
 
-void swl_set_window_resizable(swl_window *window, swl_bool is_resizable)
+static void swl_atomic_add(volatile swl_uint32 *ptr, swl_uint32 value)
 {
-    // TODO: find a way to set window become resizable
-    // swl_uint32 resizable_flag = WS_OVERLAPPEDWINDOW;
-    // if(is_resizable) {
-    //     resizable_flag = resizable_flag ^ WS_THICKFRAME;
-    // }
-    // SetWindowLongPtr(window->platform.hwnd, GWL_STYLE, resizable_flag);
+    __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
 }
 
-HINSTANCE swl_win32_get_hinstance(void)
+#if defined(__x86_64__) || defined(__i386__)
+#define swl_cpu_relax() __builtin_ia32_pause()
+#else
+#define swl_cpu_relax() ((void)0)
+#endif
+#define SWL_THREAD_LOCAL __thread
+#endif
+
+static void *swl_memset(void *dst, const int val, swl_uint32 size)
 {
-    return APP.platform.inst;
+    for(swl_uint32 i = 0; i < size; ++i)
+        ((swl_uint8 *)dst)[i] = (const swl_uint8)val;
+    return dst;
 }
 
-HWND swl_win32_get_hwnd(swl_window *window)
+static void *swl_memcpy(void *dst, const void *src, swl_uint32 size)
 {
-    return window->platform.hwnd;
+    for(swl_uint32 i = 0; i < size; ++i)
+        ((swl_uint8 *)dst)[i] = ((const swl_uint8 *)src)[i];
+    return dst;
 }
 
-void swl_poll_window_events(void)
+typedef struct swl_event_batch {
+    swl_event items[SWL_EVENT_BATCH_CAPACITY];
+    swl_uint32 count;
+} swl_event_batch;
+
+static void swl_event_batch_flush(swl_event_batch *batch)
 {
-    MSG msg;
-    if(PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
-        if(msg.message == WM_QUIT) {
-            swl_event event;
-            event.type = SWL_EVENT_WINDOW_CLOSED;
-            swl_push_event(event);
-        } else {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }
-    }
+    if(batch->count) APP.poll_stats.events_pushed += swl_push_events(batch->items, batch->count);
+    batch->count = 0;
 }
 
-LRESULT CALLBACK _swl_win32_window_proc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+// Fold event into an event already waiting in the batch, only used when coalescing is enabled
+static swl_bool swl_event_batch_coalesce(swl_event_batch *batch, const swl_event *event)
 {
-    switch(uMsg) {
-        case WM_DESTROY:
+    switch(event->type) {
+        case SWL_EVENT_MOUSE_MOVED:
             {
-                PostQuitMessage(0);
-                return 0;
+                if(!batch->count) return SWL_FALSE;
+                swl_event *last = &batch->items[batch->count - 1];
+                if(last->type != SWL_EVENT_MOUSE_MOVED || last->mouse.window != event->mouse.window)
+                    return SWL_FALSE;
+                *last = *event;
+                APP.poll_stats.motion_coalesced += 1;
+                return SWL_TRUE;
+            } break;
+        case SWL_EVENT_WINDOW_RESIZED:
+            {
+                // An older resize is dropped and the new one appended, so the
+                // final size still arrives after the events queued in between
+                for(swl_uint32 i = batch->count; i > 0; --i) {
+                    swl_event *pending = &batch->items[i - 1];
+                    if(pending->type != SWL_EVENT_WINDOW_RESIZED || pending->window.window != event->window.window)
+                        continue;
+                    APP.poll_stats.resize_coalesced += 1;
+                    if(i == batch->count) {
+                        *pending = *event;
+                        return SWL_TRUE;
+                    }
+                    for(; i < batch->count; ++i) batch->items[i - 1] = batch->items[i];
+                    batch->count -= 1;
+                    return SWL_FALSE;
+                }
             } break;
         default:
             break;
     }
-    return DefWindowProc(hWnd, uMsg, wParam, lParam);
+    return SWL_FALSE;
 }
 
-#endif // SWL_DISPLAY_WIN32
-
-#ifdef SWL_DISPLAY_X11
-static swl_bool swl_init__platform(void)
+static void swl_event_batch_add(swl_event_batch *batch, const swl_event *event)
 {
-    APP.platform.display = XOpenDisplay(NULL);
-    if(!APP.platform.display) {
-        SWL_LOG_MESSAGE("X11 display is failed to be opened");
-    }
-
-    APP.platform.colormap = XCreateColormap(APP.platform.display, XDefaultRootWindow(APP.platform.display), 
-            XDefaultVisualOfScreen(XDefaultScreenOfDisplay(APP.platform.display)), AllocNone);
-
-    APP.platform.wm_delete_window = XInternAtom(APP.platform.display, "WM_DELETE_WINDOW", False);
-
-    return SWL_TRUE;
+    if(APP.coalesce_events && swl_event_batch_coalesce(batch, event)) return;
+    if(batch->count == SWL_EVENT_BATCH_CAPACITY) swl_event_batch_flush(batch);
+    batch->items[batch->count++] = *event;
 }
 
-static void swl_deinit__platform(void)
+static void swl_event_batch_add_resize(swl_event_batch *batch, swl_window *window,
+        int x, int y, swl_uint32 width, swl_uint32 height)
 {
-    XFreeColormap(APP.platform.display, APP.platform.colormap);
-    XCloseDisplay(APP.platform.display);
+    if(window->width == width && window->height == height) return;
+
+    window->width = width;
+    window->height = height;
+
+    swl_event result;
+    result.type = SWL_EVENT_WINDOW_RESIZED;
+    result.window.window = window;
+    result.window.x = x;
+    result.window.y = y;
+    result.window.width = width;
+    result.window.height = height;
+    swl_event_batch_add(batch, &result);
 }
 
-static swl_bool swl_create_window__platform(swl_window *window, const swl_window_config *config)
+// remaining is the number of expose events still following in the same series
+static void swl_event_batch_add_expose(swl_event_batch *batch, swl_window *window,
+        int x, int y, int width, int height, int remaining)
 {
-    XSetWindowAttributes swa;
-    swa.override_redirect = True;
-    swa.border_pixel = None;
-    swa.background_pixel = XBlackPixel(APP.platform.display, XDefaultScreen(APP.platform.display));
-    swa.colormap = APP.platform.colormap;
-    swa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
-                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
-                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
-                    EnterWindowMask | LeaveWindowMask | PropertyChangeMask;
-
-    Window parent = XDefaultRootWindow(APP.platform.display);
-    Window handle = XCreateWindow(APP.platform.display, parent,
-            0, 0, config->width, config->height, 0,
-            CopyFromParent, InputOutput,
-            CopyFromParent, 
-            CWBackPixel | CWColormap | CWBorderPixel | CWEventMask,
-            &swa);
-
-    if(!window) {
-        SWL_LOG_MESSAGE("Failed to create X11 window");
-        return SWL_FALSE;
+    int x0 = x, y0 = y;
+    int x1 = x + width, y1 = y + height;
+    if(APP.coalesce_events) {
+        if(window->expose_pending) {
+            if(window->expose_x0 < x0) x0 = window->expose_x0;
+            if(window->expose_y0 < y0) y0 = window->expose_y0;
+            if(window->expose_x1 > x1) x1 = window->expose_x1;
+            if(window->expose_y1 > y1) y1 = window->expose_y1;
+        }
+        if(remaining > 0) {
+            window->expose_pending = SWL_TRUE;
+            window->expose_x0 = x0;
+            window->expose_y0 = y0;
+            window->expose_x1 = x1;
+            window->expose_y1 = y1;
+            APP.poll_stats.expose_coalesced += 1;
+            return;
+        }
+        window->expose_pending = SWL_FALSE;
     }
 
-    XSetWMProtocols(APP.platform.display, handle, &APP.platform.wm_delete_window, 1);
-
-    window->platform.window = handle;
-
-    return SWL_TRUE;
+    swl_event result;
+    result.type = SWL_EVENT_WINDOW_EXPOSED;
+    result.window.window = window;
+    result.window.x = x0;
+    result.window.y = y0;
+    result.window.width = x1 - x0;
+    result.window.height = y1 - y0;
+    swl_event_batch_add(batch, &result);
 }
 
-static void swl_destroy_window__platform(swl_window *window)
+static swl_uint32 swl_window_map_slot(swl_uint64 key)
 {
-    XDestroyWindow(window->platform.window);
+    // Fibonacci hashing, the high bits are the best mixed ones
+    return (swl_uint32)((key * 0x9E3779B97F4A7C15ull) >> 32) & (APP.window_map.capacity - 1);
 }
 
-void swl_set_window_title(swl_window *window, const char *title)
+static swl_window *swl_window_map_find(swl_uint64 key)
 {
-    if(!window) {
-        SWL_LOG_MESSAGE("Invalid window at swl_set_window_title");
-        return;
+    if(!APP.window_map.count || !key) return SWL_NULL;
+    swl_uint32 mask = APP.window_map.capacity - 1;
+    for(swl_uint32 slot = swl_window_map_slot(key);; slot = (slot + 1) & mask) {
+        swl_window_map_entry *entry = &APP.window_map.entries[slot];
+        if(entry->key == key) return entry->window;
+        if(!entry->key) return SWL_NULL;
     }
+}
 
-    XStoreName(APP.platform.display, window->platform.window, title);
-    window->title = title;
-    XSync(APP.platform.display, False);
+static void swl_window_map_place(swl_uint64 key, swl_window *window)
+{
+    swl_uint32 mask = APP.window_map.capacity - 1;
+    swl_uint32 slot = swl_window_map_slot(key);
+    while(APP.window_map.entries[slot].key && APP.window_map.entries[slot].key != key)
+        slot = (slot + 1) & mask;
+    if(!APP.window_map.entries[slot].key) APP.window_map.count += 1;
+    APP.window_map.entries[slot].key = key;
+    APP.window_map.entries[slot].window = window;
 }
 
-void swl_set_window_visible(swl_window *window, swl_bool is_visible)
+static swl_bool swl_window_map_insert(swl_uint64 key, swl_window *window)
 {
-    if(!window) {
-        SWL_LOG_MESSAGE("Invalid window passed at swl_set_window_visible");
-        return;
+    // Keep the load factor at or below one half
+    if((APP.window_map.count + 1) * 2 > APP.window_map.capacity) {
+        swl_uint32 old_capacity = APP.window_map.capacity;
+        swl_window_map_entry *old_entries = APP.window_map.entries;
+        swl_uint32 capacity = old_capacity ? old_capacity * 2 : 32;
+
+        swl_window_map_entry *entries = (swl_window_map_entry *)SWL_MALLOC(capacity * sizeof(*entries));
+        if(!entries) {
+            SWL_LOG_MESSAGE("Failed to allocate memory for the window map");
+            return SWL_FALSE;
+        }
+        swl_memset(entries, 0, capacity * sizeof(*entries));
+
+        APP.window_map.entries = entries;
+        APP.window_map.capacity = capacity;
+        APP.window_map.count = 0;
+        for(swl_uint32 i = 0; i < old_capacity; ++i) {
+            if(old_entries[i].key) swl_window_map_place(old_entries[i].key, old_entries[i].window);
+        }
+        SWL_FREE(old_entries);
     }
 
-    if(is_visible) 
-        XMapWindow(APP.platform.display, window->platform.window);
-    else 
-        XUnmapWindow(APP.platform.display, window->platform.window);
-    window->is_visible = is_visible;
-    XSync(APP.platform.display, False);
+    swl_window_map_place(key, window);
+    return SWL_TRUE;
 }
 
-void swl_set_window_resizable(swl_window *window, swl_bool is_resizable)
+static void swl_window_map_remove(swl_uint64 key)
 {
-    Display *display = APP.platform.display;
-    Window x11_window = window->platform.window;
-    XSizeHints *hints = XAllocSizeHints();
-    long supplied;
-    XGetWMNormalHints(display, x11_window, hints, &supplied);
-    // Reset min and max size when enabling resize
-    if (is_resizable) {
-        SWL_LOG_MESSAGE("Window is resizable");
-        hints->flags &= ~(PMinSize | PMaxSize);
-    } else {
-        SWL_LOG_MESSAGE("Window is not resizable");
-        // Set min and max size to current size when disabling resize
-        hints->flags |= (USPosition | PAspect | PMinSize | PMaxSize);
-        hints->min_width = hints->max_width = window->width;
-        hints->min_height = hints->max_height = window->height;
-    }
-    XSetWMNormalHints(display, x11_window, hints);
-    XFree(hints);
-    XSync(display, False);
+    if(!APP.window_map.count || !key) return;
+    swl_uint32 mask = APP.window_map.capacity - 1;
+    swl_uint32 slot = swl_window_map_slot(key);
+    while(APP.window_map.entries[slot].key != key) {
+        if(!APP.window_map.entries[slot].key) return;
+        slot = (slot + 1) & mask;
+    }
 
-    window->is_resizable = is_resizable;
+    // Backward shift deletion keeps probe sequences intact without tombstones
+    swl_uint32 hole = slot;
+    for(swl_uint32 next = (hole + 1) & mask; APP.window_map.entries[next].key; next = (next + 1) & mask) {
+        swl_uint32 home = swl_window_map_slot(APP.window_map.entries[next].key);
+        if(((next - home) & mask) >= ((next - hole) & mask)) {
+            APP.window_map.entries[hole] = APP.window_map.entries[next];
+            hole = next;
+        }
+    }
+    APP.window_map.entries[hole].key = 0;
+    APP.window_map.entries[hole].window = SWL_NULL;
+    APP.window_map.count -= 1;
 }
 
-void swl_poll_window_events(void)
+static swl_window *swl_window_pool_acquire(void)
 {
-    XEvent xevent;
-    while(XPending(APP.platform.display) > 0) {
-        XNextEvent(APP.platform.display, &xevent);
-        swl_event result;
-        int scancode;
-
-        // HACK: Save scancode as some IMs clear the field in XFilterEvent
-        if (xevent.type == KeyPress || xevent.type == KeyRelease) scancode = xevent.xkey.keycode;
-
-        Bool filtered = False;
-        filtered = XFilterEvent(&xevent, None);
-        (void)filtered;
-
-        switch(xevent.type) {
-            case ClientMessage:
-                {
-                    if((Atom)xevent.xclient.data.l[0] == APP.platform.wm_delete_window) {
-                        result.type = SWL_EVENT_WINDOW_CLOSED;
-                        result.window.window = SWL_NULL;
-                        for(swl_uint32 i = 0; i < SWL_MAXIMUM_WINDOW_CREATED; ++i) {
-                            swl_window *window = &APP.windows[i];
-                            if(window->platform.window == xevent.xclient.window) {
-                                result.window.window = window;
-                            }
-                        }
-                        swl_push_event(result);
-                    }
-                } break;
-            case KeyPress:
-            case KeyRelease:
-                {
-                    if(xevent.type == KeyPress) result.type = SWL_EVENT_KEY_PRESSED;
-                    if(xevent.type == KeyRelease) result.type = SWL_EVENT_KEY_RELEASED;
-                    result.key.scancode = scancode;
-                    // result.key.mods = translate_platform.key_state(xevent.xkey.state);
-                    // result.key.keycode = translate_platform.key(scancode);
-                    // if(result.key.keycode < 0) break;
-                    swl_push_event(result);
-                } break;
-            case ButtonPress:
-            case ButtonRelease:
-                {
-                } break;
-            default:
-                break;
+    if(!APP.window_pool.free_list) {
+        swl_window_block *block = (swl_window_block *)SWL_MALLOC(sizeof(*block));
+        if(!block) {
+            SWL_LOG_MESSAGE("Failed to allocate memory for the window pool");
+            return SWL_NULL;
         }
+        swl_memset(block, 0, sizeof(*block));
 
+        block->next = APP.window_pool.blocks;
+        APP.window_pool.blocks = block;
+        for(swl_uint32 i = SWL_WINDOW_POOL_BLOCK_SIZE; i > 0; --i) {
+            block->windows[i - 1].next_free = APP.window_pool.free_list;
+            APP.window_pool.free_list = &block->windows[i - 1];
+        }
     }
+
+    swl_window *window = APP.window_pool.free_list;
+    APP.window_pool.free_list = window->next_free;
+    swl_memset(window, 0, sizeof(*window));
+    return window;
 }
 
-Display *swl_x11_get_display(void)
+static void swl_window_pool_release(swl_window *window)
 {
-    return APP.platform.display;
+    window->initialized = SWL_FALSE;
+    window->next_free = APP.window_pool.free_list;
+    APP.window_pool.free_list = window;
 }
 
-Window swl_x11_get_window(swl_window *window)
+static void swl_window_pool_deinit(void)
 {
-    return window->platform.window;
+    while(APP.window_pool.blocks) {
+        swl_window_block *next = APP.window_pool.blocks->next;
+        SWL_FREE(APP.window_pool.blocks);
+        APP.window_pool.blocks = next;
+    }
+    APP.window_pool.free_list = SWL_NULL;
+
+    SWL_FREE(APP.window_map.entries);
+    APP.window_map.entries = SWL_NULL;
+    APP.window_map.capacity = 0;
+    APP.window_map.count = 0;
 }
 
-#endif // SWL_DISPLAY_X11
+static void swl_commit_window__platform(swl_window *window);
 
-swl_bool swl_init(void)
+// Send the pending property changes of every window, done at the start of each poll
+static void swl_commit_dirty_windows(void)
 {
-    if(APP.initialized) {
-        SWL_LOG_MESSAGE("Application is already initialized");
-        return SWL_FALSE;
+    for(swl_window_block *block = APP.window_pool.blocks; block; block = block->next) {
+        for(swl_uint32 i = 0; i < SWL_WINDOW_POOL_BLOCK_SIZE; ++i) {
+            swl_window *window = &block->windows[i];
+            if(!window->initialized || !window->dirty) continue;
+            swl_commit_window__platform(window);
+            window->dirty = 0;
+        }
     }
+}
 
-    if(!swl_init__platform()) {
-        SWL_LOG_MESSAGE("Failed to initialize platform spesific data of application");
+// Intersection of a present rectangle with the framebuffer, SWL_FALSE when empty
+static swl_bool swl_clip_framebuffer_rect(const swl_framebuffer *framebuffer, const swl_rect *rect,
+        int *x, int *y, int *width, int *height)
+{
+    long long x0 = rect->x, y0 = rect->y;
+    long long x1 = x0 + rect->width, y1 = y0 + rect->height;
+    if(x0 < 0) x0 = 0;
+    if(y0 < 0) y0 = 0;
+    if(x1 > framebuffer->width) x1 = framebuffer->width;
+    if(y1 > framebuffer->height) y1 = framebuffer->height;
+    if(x0 >= x1 || y0 >= y1) return SWL_FALSE;
+
+    *x = (int)x0;
+    *y = (int)y0;
+    *width = (int)(x1 - x0);
+    *height = (int)(y1 - y0);
+    return SWL_TRUE;
+}
+
+#if defined(SWL_DISPLAY_X11) || defined(SWL_DISPLAY_XCB)
+static swl_uint64 swl_get_time_ns__posix(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (swl_uint64)ts.tv_sec * 1000000000ull + (swl_uint64)ts.tv_nsec;
+}
+
+static int swl_create_wakeup_fd__posix(void)
+{
+    int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if(fd < 0) {
+        SWL_LOG_MESSAGE("Failed to create eventfd, swl_post_empty_event will not wake up waiters");
+    }
+    return fd;
+}
+
+// Block until the connection is readable, the wakeup fd is signaled or the timeout expires
+static void swl_wait_for_connection__posix(int connection_fd, int wakeup_fd,
+        swl_bool has_timeout, swl_uint64 timeout_ns)
+{
+    struct pollfd fds[2];
+    nfds_t fd_count = 1;
+    fds[0].fd = connection_fd;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    if(wakeup_fd >= 0) {
+        fds[1].fd = wakeup_fd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        fd_count = 2;
+    }
+
+    swl_uint64 deadline = has_timeout ? swl_get_time_ns__posix() + timeout_ns : 0;
+    for(;;) {
+        int timeout_ms = -1;
+        if(has_timeout) {
+            swl_uint64 now = swl_get_time_ns__posix();
+            swl_uint64 remaining_ms = now < deadline ? (deadline - now + 999999) / 1000000 : 0;
+            timeout_ms = remaining_ms > 0x7fffffff ? 0x7fffffff : (int)remaining_ms;
+        }
+        if(poll(fds, fd_count, timeout_ms) >= 0 || errno != EINTR) break;
+    }
+
+    if(fd_count == 2 && (fds[1].revents & POLLIN)) {
+        eventfd_t value;
+        eventfd_read(wakeup_fd, &value);
+    }
+}
+#endif
+
+#if defined(SWL_DISPLAY_X11) || defined(SWL_DISPLAY_XCB)
+// Keysyms and modifier bits are defined by the core protocol, shared by the Xlib and XCB backends
+static int swl_translate_keysym__x11(swl_uint32 keysym)
+{
+    if(keysym >= XK_a && keysym <= XK_z) return SWL_KEY_A + (int)(keysym - XK_a);
+    if(keysym >= XK_A && keysym <= XK_Z) return SWL_KEY_A + (int)(keysym - XK_A);
+    if(keysym >= XK_0 && keysym <= XK_9) return SWL_KEY_0 + (int)(keysym - XK_0);
+    if(keysym >= XK_F1 && keysym <= XK_F25) return SWL_KEY_F1 + (int)(keysym - XK_F1);
+    if(keysym >= XK_KP_0 && keysym <= XK_KP_9) return SWL_KEY_KP_0 + (int)(keysym - XK_KP_0);
+
+    switch(keysym) {
+        case XK_space:          return SWL_KEY_SPACE;
+        case XK_apostrophe:     return SWL_KEY_APOSTROPHE;
+        case XK_comma:          return SWL_KEY_COMMA;
+        case XK_minus:          return SWL_KEY_MINUS;
+        case XK_period:         return SWL_KEY_PERIOD;
+        case XK_slash:          return SWL_KEY_SLASH;
+        case XK_semicolon:      return SWL_KEY_SEMICOLON;
+        case XK_equal:          return SWL_KEY_EQUAL;
+        case XK_bracketleft:    return SWL_KEY_LEFT_BRACKET;
+        case XK_backslash:      return SWL_KEY_BACKSLASH;
+        case XK_bracketright:   return SWL_KEY_RIGHT_BRACKET;
+        case XK_grave:          return SWL_KEY_GRAVE_ACCENT;
+        case XK_less:           return SWL_KEY_WORLD_1;
+        case XK_Escape:         return SWL_KEY_ESCAPE;
+        case XK_Return:         return SWL_KEY_ENTER;
+        case XK_Tab:            return SWL_KEY_TAB;
+        case XK_BackSpace:      return SWL_KEY_BACKSPACE;
+        case XK_Insert:         return SWL_KEY_INSERT;
+        case XK_Delete:         return SWL_KEY_DELETE;
+        case XK_Right:          return SWL_KEY_RIGHT;
+        case XK_Left:           return SWL_KEY_LEFT;
+        case XK_Down:           return SWL_KEY_DOWN;
+        case XK_Up:             return SWL_KEY_UP;
+        case XK_Page_Up:        return SWL_KEY_PAGE_UP;
+        case XK_Page_Down:      return SWL_KEY_PAGE_DOWN;
+        case XK_Home:           return SWL_KEY_HOME;
+        case XK_End:            return SWL_KEY_END;
+        case XK_Caps_Lock:      return SWL_KEY_CAPS_LOCK;
+        case XK_Scroll_Lock:    return SWL_KEY_SCROLL_LOCK;
+        case XK_Num_Lock:       return SWL_KEY_NUM_LOCK;
+        case XK_Print:          return SWL_KEY_PRINT_SCREEN;
+        case XK_Pause:          return SWL_KEY_PAUSE;
+        case XK_KP_Decimal:     return SWL_KEY_KP_DECIMAL;
+        case XK_KP_Separator:   return SWL_KEY_KP_DECIMAL;
+        case XK_KP_Divide:      return SWL_KEY_KP_DIVIDE;
+        case XK_KP_Multiply:    return SWL_KEY_KP_MULTIPLY;
+        case XK_KP_Subtract:    return SWL_KEY_KP_SUBTRACT;
+        case XK_KP_Add:         return SWL_KEY_KP_ADD;
+        case XK_KP_Enter:       return SWL_KEY_KP_ENTER;
+        case XK_KP_Equal:       return SWL_KEY_KP_EQUAL;
+        case XK_Shift_L:        return SWL_KEY_LEFT_SHIFT;
+        case XK_Control_L:      return SWL_KEY_LEFT_CONTROL;
+        case XK_Alt_L:          return SWL_KEY_LEFT_ALT;
+        case XK_Meta_L:         return SWL_KEY_LEFT_ALT;
+        case XK_Super_L:        return SWL_KEY_LEFT_SUPER;
+        case XK_Shift_R:        return SWL_KEY_RIGHT_SHIFT;
+        case XK_Control_R:      return SWL_KEY_RIGHT_CONTROL;
+        case XK_Alt_R:          return SWL_KEY_RIGHT_ALT;
+        case XK_Meta_R:         return SWL_KEY_RIGHT_ALT;
+        case XK_ISO_Level3_Shift: return SWL_KEY_RIGHT_ALT;
+        case XK_Mode_switch:    return SWL_KEY_RIGHT_ALT;
+        case XK_Super_R:        return SWL_KEY_RIGHT_SUPER;
+        case XK_Menu:           return SWL_KEY_MENU;
+        default:                break;
+    }
+    return SWL_KEY_INVALID;
+}
+
+// Keypad keys are looked up on the second level so they translate the same regardless of Num Lock
+static int swl_translate_keysyms__x11(swl_uint32 level0, swl_uint32 level1)
+{
+    int key = swl_translate_keysym__x11(level1);
+    if(key >= SWL_KEY_KP_0 && key <= SWL_KEY_KP_EQUAL) return key;
+    return swl_translate_keysym__x11(level0);
+}
+
+static int swl_translate_mods__x11(unsigned int state)
+{
+    int mods = 0;
+    if(state & ShiftMask)   mods |= SWL_MOD_SHIFT;
+    if(state & ControlMask) mods |= SWL_MOD_CONTROL;
+    if(state & Mod1Mask)    mods |= SWL_MOD_ALT;
+    if(state & Mod4Mask)    mods |= SWL_MOD_SUPER;
+    if(state & LockMask)    mods |= SWL_MOD_CAPS_LOCK;
+    if(state & Mod2Mask)    mods |= SWL_MOD_NUM_LOCK;
+    return mods;
+}
+
+static void swl_reset_key_tables__x11(int *keycodes, int *scancodes)
+{
+    for(swl_uint32 i = 0; i < 256; ++i) keycodes[i] = SWL_KEY_INVALID;
+    for(swl_uint32 i = 0; i <= SWL_KEY_LAST; ++i) scancodes[i] = -1;
+}
+
+static void swl_fill_scancodes__x11(const int *keycodes, int *scancodes)
+{
+    for(swl_uint32 i = 0; i < 256; ++i) {
+        if(keycodes[i] >= 0 && scancodes[keycodes[i]] < 0) scancodes[keycodes[i]] = (int)i;
+    }
+}
+
+static int swl_key_translate__x11(const int *keycodes, int scancode)
+{
+    if(scancode < 0 || scancode > 255) return SWL_KEY_INVALID;
+    return keycodes[scancode];
+}
+
+// Server timestamps are 32-bit milliseconds that wrap around every ~49.7 days,
+// extend them to 64 bits so they keep increasing across the wrap
+static swl_uint64 swl_server_time_to_ns__x11(swl_uint32 *last, swl_uint64 *high, swl_uint32 time)
+{
+    // Late event from before the last wrap
+    if(*high && time > *last && time - *last > 0x80000000u)
+        return (*high - (1ull << 32) + time) * 1000000ull;
+
+    if(time < *last && *last - time > 0x80000000u) *high += 1ull << 32;
+    *last = time;
+    return (*high + time) * 1000000ull;
+}
+
+// Cached colormap slot for the visual, *is_new is set when the caller has to create it
+static swl_colormap__x11 *swl_colormap_slot__x11(swl_uint32 visual_id, swl_bool *is_new)
+{
+    *is_new = SWL_FALSE;
+    for(swl_uint32 i = 0; i < APP.platform.colormap_count; ++i) {
+        if(APP.platform.colormaps[i].visual_id == visual_id) return &APP.platform.colormaps[i];
+    }
+
+    if(APP.platform.colormap_count == APP.platform.colormap_capacity) {
+        swl_uint32 capacity = APP.platform.colormap_capacity ? APP.platform.colormap_capacity * 2 : 4;
+        swl_colormap__x11 *colormaps = (swl_colormap__x11 *)SWL_MALLOC(capacity * sizeof(*colormaps));
+        if(!colormaps) {
+            SWL_LOG_MESSAGE("Failed to allocate the colormap cache");
+            return SWL_NULL;
+        }
+        if(APP.platform.colormaps) {
+            swl_memcpy(colormaps, APP.platform.colormaps, APP.platform.colormap_count * sizeof(*colormaps));
+            SWL_FREE(APP.platform.colormaps);
+        }
+        APP.platform.colormaps = colormaps;
+        APP.platform.colormap_capacity = capacity;
+    }
+
+    swl_colormap__x11 *slot = &APP.platform.colormaps[APP.platform.colormap_count++];
+    slot->visual_id = visual_id;
+    slot->colormap = 0;
+    *is_new = SWL_TRUE;
+    return slot;
+}
+
+static void swl_free_colormaps__x11(void)
+{
+    SWL_FREE(APP.platform.colormaps);
+    APP.platform.colormaps = SWL_NULL;
+    APP.platform.colormap_count = 0;
+    APP.platform.colormap_capacity = 0;
+}
+#endif
+
+#ifdef SWL_DISPLAY_WIN32
+void swl_wait_events(void)
+{
+    // Pending changes such as showing the window may be what produces the next event
+    swl_commit_dirty_windows();
+    WaitMessage();
+    swl_poll_window_events();
+}
+
+void swl_wait_events_timeout(swl_uint64 timeout_ns)
+{
+    swl_uint64 timeout_ms = (timeout_ns + 999999) / 1000000;
+    if(timeout_ms >= INFINITE) timeout_ms = INFINITE - 1;
+    swl_commit_dirty_windows();
+    MsgWaitForMultipleObjects(0, SWL_NULL, FALSE, (DWORD)timeout_ms, QS_ALLINPUT);
+    swl_poll_window_events();
+}
+
+void swl_post_empty_event(void)
+{
+    PostThreadMessage(APP.platform.thread_id, WM_NULL, 0, 0);
+}
+
+LRESULT CALLBACK _swl_win32_window_proc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+static swl_bool swl_init__platform(void)
+{
+    APP.platform.wcls_name = "SimpleWindowLibraryWi32Window";
+    APP.platform.inst = (HINSTANCE)GetModuleHandle(SWL_NULL);
+    if(!APP.platform.inst) {
+        SWL_LOG_MESSAGE("Failed to get the module handle");
+        return SWL_FALSE;
+    }
+
+    swl_memset(&APP.platform.wcls, 0, sizeof(APP.platform.wcls));
+    APP.platform.wcls.style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
+    APP.platform.wcls.lpfnWndProc = _swl_win32_window_proc;
+    APP.platform.wcls.hInstance = APP.platform.inst;
+    APP.platform.wcls.hIcon = LoadIcon(APP.platform.inst, IDI_APPLICATION);
+    APP.platform.wcls.hCursor = LoadCursor(SWL_NULL, IDC_ARROW);
+    APP.platform.wcls.hbrBackground = (HBRUSH)COLOR_WINDOW;
+    APP.platform.wcls.lpszClassName = APP.platform.wcls_name;
+
+    APP.platform.wcls_atom = RegisterClass(&APP.platform.wcls);
+    if(!APP.platform.wcls_atom) {
+        SWL_LOG_MESSAGE("Failed to register window class");
+        return SWL_FALSE;
+    }
+
+    APP.platform.thread_id = GetCurrentThreadId();
+
+    return SWL_TRUE;
+}
+
+static void swl_deinit__platform(void)
+{
+
+}
+
+static swl_bool swl_create_window__platform(swl_window *window, const swl_window_config *config,
+        swl_uint32 visual_id, swl_uint32 depth)
+{
+    (void)visual_id;
+    (void)depth;
+    RECT content;
+    swl_memset(&content, 0, sizeof(content));
+    content.right = config->width;
+    content.bottom = config->height;
+
+    HWND hwnd = CreateWindowEx(
+            WS_EX_APPWINDOW,
+            MAKEINTATOM(APP.platform.wcls_atom),
+            config->title,
+            WS_OVERLAPPEDWINDOW,
+            CW_USEDEFAULT,
+            CW_USEDEFAULT,
+            content.right - content.left,
+            content.bottom - content.top,
+            SWL_NULL,
+            SWL_NULL,
+            APP.platform.inst,
+            SWL_NULL);
+
+    if(!hwnd) {
+        SWL_LOG_MESSAGE("Failed to create win32 window");
+        return SWL_FALSE;
+    }
+
+    window->platform.hwnd = hwnd;
+
+    return SWL_TRUE;
+}
+
+static swl_uint64 swl_window_key__platform(swl_window *window)
+{
+    return (swl_uint64)(ULONG_PTR)window->platform.hwnd;
+}
+
+static void swl_destroy_window__platform(swl_window *window)
+{
+}
+
+static void swl_commit_window__platform(swl_window *window)
+{
+    if(window->dirty & SWL_WINDOW_DIRTY_TITLE)
+        SetWindowText(window->platform.hwnd, window->title);
+
+    // TODO: find a way to set window become resizable
+    // swl_uint32 resizable_flag = WS_OVERLAPPEDWINDOW;
+    // if(is_resizable) {
+    //     resizable_flag = resizable_flag ^ WS_THICKFRAME;
+    // }
+    // SetWindowLongPtr(window->platform.hwnd, GWL_STYLE, resizable_flag);
+
+    if(window->dirty & SWL_WINDOW_DIRTY_VISIBLE)
+        ShowWindow(window->platform.hwnd, window->is_visible ? SW_SHOWNA : SW_HIDE);
+}
+
+static void swl_flush__platform(void)
+{
+}
+
+HINSTANCE swl_win32_get_hinstance(void)
+{
+    return APP.platform.inst;
+}
+
+HWND swl_win32_get_hwnd(swl_window *window)
+{
+    return window->platform.hwnd;
+}
+
+static swl_bool swl_create_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    BITMAPINFOHEADER *header = &framebuffer->platform.info.bmiHeader;
+    swl_memset(&framebuffer->platform.info, 0, sizeof(framebuffer->platform.info));
+    header->biSize = sizeof(*header);
+    header->biWidth = (LONG)framebuffer->width;
+    // Negative height stores the rows top-down like the X11 backends
+    header->biHeight = -(LONG)framebuffer->height;
+    header->biPlanes = 1;
+    header->biBitCount = 32;
+    header->biCompression = BI_RGB;
+
+    framebuffer->stride = framebuffer->width * 4;
+    framebuffer->buffers[0].pixels = SWL_MALLOC((size_t)framebuffer->stride * framebuffer->height);
+    if(!framebuffer->buffers[0].pixels) {
+        SWL_LOG_MESSAGE("Failed to allocate framebuffer pixels");
+        return SWL_FALSE;
+    }
+    framebuffer->buffer_count = 1;
+    return SWL_TRUE;
+}
+
+static void swl_destroy_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    SWL_FREE(framebuffer->buffers[0].pixels);
+}
+
+static void swl_present_framebuffer__platform(swl_framebuffer *framebuffer, int index,
+        const swl_rect *rects, swl_uint32 rect_count)
+{
+    // GDI copies the whole buffer, the rectangles only matter for shared buffers
+    (void)rects;
+    (void)rect_count;
+    HWND hwnd = framebuffer->window->platform.hwnd;
+    HDC dc = GetDC(hwnd);
+    StretchDIBits(dc, 0, 0, (int)framebuffer->width, (int)framebuffer->height,
+            0, 0, (int)framebuffer->width, (int)framebuffer->height,
+            framebuffer->buffers[index].pixels, &framebuffer->platform.info, DIB_RGB_COLORS, SRCCOPY);
+    ReleaseDC(hwnd, dc);
+}
+
+void swl_poll_window_events(void)
+{
+    MSG msg;
+    swl_commit_dirty_windows();
+    if(PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+        if(msg.message == WM_QUIT) {
+            swl_event event;
+            event.type = SWL_EVENT_WINDOW_CLOSED;
+            swl_push_event(event);
+        } else {
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+    }
+}
+
+LRESULT CALLBACK _swl_win32_window_proc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    switch(uMsg) {
+        case WM_DESTROY:
+            {
+                PostQuitMessage(0);
+                return 0;
+            } break;
+        default:
+            break;
+    }
+    return DefWindowProc(hWnd, uMsg, wParam, lParam);
+}
+
+#endif // SWL_DISPLAY_WIN32
+
+#ifdef SWL_DISPLAY_X11
+// XKB key names describe physical positions, so they are independent of the active layout
+static const struct {
+    int key;
+    char name[XkbKeyNameLength + 1];
+} swl_xkb_key_names[] = {
+    { SWL_KEY_GRAVE_ACCENT, "TLDE" },
+    { SWL_KEY_1, "AE01" },
+    { SWL_KEY_2, "AE02" },
+    { SWL_KEY_3, "AE03" },
+    { SWL_KEY_4, "AE04" },
+    { SWL_KEY_5, "AE05" },
+    { SWL_KEY_6, "AE06" },
+    { SWL_KEY_7, "AE07" },
+    { SWL_KEY_8, "AE08" },
+    { SWL_KEY_9, "AE09" },
+    { SWL_KEY_0, "AE10" },
+    { SWL_KEY_MINUS, "AE11" },
+    { SWL_KEY_EQUAL, "AE12" },
+    { SWL_KEY_Q, "AD01" },
+    { SWL_KEY_W, "AD02" },
+    { SWL_KEY_E, "AD03" },
+    { SWL_KEY_R, "AD04" },
+    { SWL_KEY_T, "AD05" },
+    { SWL_KEY_Y, "AD06" },
+    { SWL_KEY_U, "AD07" },
+    { SWL_KEY_I, "AD08" },
+    { SWL_KEY_O, "AD09" },
+    { SWL_KEY_P, "AD10" },
+    { SWL_KEY_LEFT_BRACKET, "AD11" },
+    { SWL_KEY_RIGHT_BRACKET, "AD12" },
+    { SWL_KEY_A, "AC01" },
+    { SWL_KEY_S, "AC02" },
+    { SWL_KEY_D, "AC03" },
+    { SWL_KEY_F, "AC04" },
+    { SWL_KEY_G, "AC05" },
+    { SWL_KEY_H, "AC06" },
+    { SWL_KEY_J, "AC07" },
+    { SWL_KEY_K, "AC08" },
+    { SWL_KEY_L, "AC09" },
+    { SWL_KEY_SEMICOLON, "AC10" },
+    { SWL_KEY_APOSTROPHE, "AC11" },
+    { SWL_KEY_Z, "AB01" },
+    { SWL_KEY_X, "AB02" },
+    { SWL_KEY_C, "AB03" },
+    { SWL_KEY_V, "AB04" },
+    { SWL_KEY_B, "AB05" },
+    { SWL_KEY_N, "AB06" },
+    { SWL_KEY_M, "AB07" },
+    { SWL_KEY_COMMA, "AB08" },
+    { SWL_KEY_PERIOD, "AB09" },
+    { SWL_KEY_SLASH, "AB10" },
+    { SWL_KEY_BACKSLASH, "BKSL" },
+    { SWL_KEY_WORLD_1, "LSGT" },
+    { SWL_KEY_SPACE, "SPCE" },
+    { SWL_KEY_ESCAPE, "ESC" },
+    { SWL_KEY_ENTER, "RTRN" },
+    { SWL_KEY_TAB, "TAB" },
+    { SWL_KEY_BACKSPACE, "BKSP" },
+    { SWL_KEY_INSERT, "INS" },
+    { SWL_KEY_DELETE, "DELE" },
+    { SWL_KEY_RIGHT, "RGHT" },
+    { SWL_KEY_LEFT, "LEFT" },
+    { SWL_KEY_DOWN, "DOWN" },
+    { SWL_KEY_UP, "UP" },
+    { SWL_KEY_PAGE_UP, "PGUP" },
+    { SWL_KEY_PAGE_DOWN, "PGDN" },
+    { SWL_KEY_HOME, "HOME" },
+    { SWL_KEY_END, "END" },
+    { SWL_KEY_CAPS_LOCK, "CAPS" },
+    { SWL_KEY_SCROLL_LOCK, "SCLK" },
+    { SWL_KEY_NUM_LOCK, "NMLK" },
+    { SWL_KEY_PRINT_SCREEN, "PRSC" },
+    { SWL_KEY_PAUSE, "PAUS" },
+    { SWL_KEY_F1, "FK01" },
+    { SWL_KEY_F2, "FK02" },
+    { SWL_KEY_F3, "FK03" },
+    { SWL_KEY_F4, "FK04" },
+    { SWL_KEY_F5, "FK05" },
+    { SWL_KEY_F6, "FK06" },
+    { SWL_KEY_F7, "FK07" },
+    { SWL_KEY_F8, "FK08" },
+    { SWL_KEY_F9, "FK09" },
+    { SWL_KEY_F10, "FK10" },
+    { SWL_KEY_F11, "FK11" },
+    { SWL_KEY_F12, "FK12" },
+    { SWL_KEY_F13, "FK13" },
+    { SWL_KEY_F14, "FK14" },
+    { SWL_KEY_F15, "FK15" },
+    { SWL_KEY_F16, "FK16" },
+    { SWL_KEY_F17, "FK17" },
+    { SWL_KEY_F18, "FK18" },
+    { SWL_KEY_F19, "FK19" },
+    { SWL_KEY_F20, "FK20" },
+    { SWL_KEY_F21, "FK21" },
+    { SWL_KEY_F22, "FK22" },
+    { SWL_KEY_F23, "FK23" },
+    { SWL_KEY_F24, "FK24" },
+    { SWL_KEY_F25, "FK25" },
+    { SWL_KEY_KP_0, "KP0" },
+    { SWL_KEY_KP_1, "KP1" },
+    { SWL_KEY_KP_2, "KP2" },
+    { SWL_KEY_KP_3, "KP3" },
+    { SWL_KEY_KP_4, "KP4" },
+    { SWL_KEY_KP_5, "KP5" },
+    { SWL_KEY_KP_6, "KP6" },
+    { SWL_KEY_KP_7, "KP7" },
+    { SWL_KEY_KP_8, "KP8" },
+    { SWL_KEY_KP_9, "KP9" },
+    { SWL_KEY_KP_DECIMAL, "KPDL" },
+    { SWL_KEY_KP_DIVIDE, "KPDV" },
+    { SWL_KEY_KP_MULTIPLY, "KPMU" },
+    { SWL_KEY_KP_SUBTRACT, "KPSU" },
+    { SWL_KEY_KP_ADD, "KPAD" },
+    { SWL_KEY_KP_ENTER, "KPEN" },
+    { SWL_KEY_KP_EQUAL, "KPEQ" },
+    { SWL_KEY_LEFT_SHIFT, "LFSH" },
+    { SWL_KEY_LEFT_CONTROL, "LCTL" },
+    { SWL_KEY_LEFT_ALT, "LALT" },
+    { SWL_KEY_LEFT_SUPER, "LWIN" },
+    { SWL_KEY_RIGHT_SHIFT, "RTSH" },
+    { SWL_KEY_RIGHT_CONTROL, "RCTL" },
+    { SWL_KEY_RIGHT_ALT, "RALT" },
+    { SWL_KEY_RIGHT_ALT, "LVL3" },
+    { SWL_KEY_RIGHT_ALT, "MDSW" },
+    { SWL_KEY_RIGHT_SUPER, "RWIN" },
+    { SWL_KEY_MENU, "MENU" },
+};
+
+static swl_bool swl_xkb_name_equal(const char *a, const char *b)
+{
+    for(swl_uint32 i = 0; i < XkbKeyNameLength; ++i) {
+        if(a[i] != b[i]) return SWL_FALSE;
+        if(!a[i]) break;
+    }
+    return SWL_TRUE;
+}
+
+static int swl_xkb_name_to_key(const char *name)
+{
+    for(swl_uint32 i = 0; i < sizeof(swl_xkb_key_names) / sizeof(swl_xkb_key_names[0]); ++i) {
+        if(swl_xkb_name_equal(name, swl_xkb_key_names[i].name)) return swl_xkb_key_names[i].key;
+    }
+    return SWL_KEY_INVALID;
+}
+
+#define SWL_SERVER_TIME(time) \
+    swl_server_time_to_ns__x11(&APP.platform.server_time, &APP.platform.server_time_high, (swl_uint32)(time))
+
+#ifdef SWL_USE_XINPUT2
+// Raw events are only selected on the root window and carry the device values before acceleration
+static void swl_select_raw_input__platform(void)
+{
+    Display *display = APP.platform.display;
+    int event_base, error_base;
+    if(!XQueryExtension(display, "XInputExtension", &APP.platform.xi_opcode, &event_base, &error_base)) {
+        SWL_LOG_MESSAGE("XInput extension is not available, raw mouse input is disabled");
+        return;
+    }
+
+    int major = 2, minor = 0;
+    if(XIQueryVersion(display, &major, &minor) != Success) {
+        SWL_LOG_MESSAGE("XInput 2.0 is not supported, raw mouse input is disabled");
+        return;
+    }
+
+    unsigned char mask[XIMaskLen(XI_LASTEVENT)] = {0};
+    XIEventMask event_mask;
+    event_mask.deviceid = XIAllMasterDevices;
+    event_mask.mask_len = sizeof(mask);
+    event_mask.mask = mask;
+    XISetMask(mask, XI_RawMotion);
+    XISelectEvents(display, XDefaultRootWindow(display), &event_mask, 1);
+
+    APP.raw_motion.is_available = SWL_TRUE;
+}
+
+// Buttons keep coming from the core events, raw ones are screen wide and carry no window position
+static void swl_translate_raw_event__platform(const XIRawEvent *raw)
+{
+    // Raw events are reported for the whole screen, drop them while none of our windows has focus
+    if(!APP.platform.focused_window || raw->evtype != XI_RawMotion) return;
+
+    // Values are packed, only the valuators set in the mask are present. Xlib
+    // doesn't align them to 8 bytes, so they are copied out.
+    const double *values = raw->raw_values;
+    double value;
+    if(raw->valuators.mask_len > 0) {
+        if(XIMaskIsSet(raw->valuators.mask, 0)) {
+            swl_memcpy(&value, values++, sizeof(value));
+            APP.raw_motion.dx += value;
+        }
+        if(XIMaskIsSet(raw->valuators.mask, 1)) {
+            swl_memcpy(&value, values, sizeof(value));
+            APP.raw_motion.dy += value;
+        }
+    }
+    APP.raw_motion.time = SWL_SERVER_TIME(raw->time);
+    APP.poll_stats.raw_motion_accumulated += 1;
+}
+#endif
+
+// Built once at init and on MappingNotify so key events only need a table load
+static void swl_create_key_tables__platform(void)
+{
+    Display *display = APP.platform.display;
+    int min_scancode = 0, max_scancode = 0;
+    XDisplayKeycodes(display, &min_scancode, &max_scancode);
+    if(max_scancode > 255) max_scancode = 255;
+
+    swl_reset_key_tables__x11(APP.platform.keycodes, APP.platform.scancodes);
+
+    if(APP.platform.xkb_available) {
+        XkbDescPtr desc = XkbGetMap(display, 0, XkbUseCoreKbd);
+        if(desc) {
+            XkbGetNames(display, XkbKeyNamesMask | XkbKeyAliasesMask, desc);
+            if(desc->names) {
+                for(int scancode = min_scancode; scancode <= max_scancode; ++scancode) {
+                    int key = swl_xkb_name_to_key(desc->names->keys[scancode].name);
+
+                    // Fall back to the aliases of this key, e.g. "AC12" for "BKSL" on ISO keyboards
+                    for(int i = 0; key < 0 && i < desc->names->num_key_aliases; ++i) {
+                        XkbKeyAliasPtr alias = &desc->names->key_aliases[i];
+                        if(swl_xkb_name_equal(alias->real, desc->names->keys[scancode].name))
+                            key = swl_xkb_name_to_key(alias->alias);
+                    }
+                    APP.platform.keycodes[scancode] = key;
+                }
+                XkbFreeNames(desc, XkbKeyNamesMask | XkbKeyAliasesMask, True);
+            }
+            XkbFreeKeyboard(desc, 0, True);
+        }
+
+        for(int scancode = min_scancode; scancode <= max_scancode; ++scancode) {
+            if(APP.platform.keycodes[scancode] >= 0) continue;
+            APP.platform.keycodes[scancode] = swl_translate_keysyms__x11(
+                    (swl_uint32)XkbKeycodeToKeysym(display, (KeyCode)scancode, 0, 0),
+                    (swl_uint32)XkbKeycodeToKeysym(display, (KeyCode)scancode, 0, 1));
+        }
+    } else {
+        int width = 0;
+        KeySym *keysyms = XGetKeyboardMapping(display, (KeyCode)min_scancode,
+                max_scancode - min_scancode + 1, &width);
+        if(keysyms) {
+            for(int scancode = min_scancode; scancode <= max_scancode; ++scancode) {
+                KeySym *entry = &keysyms[(scancode - min_scancode) * width];
+                APP.platform.keycodes[scancode] = swl_translate_keysyms__x11(
+                        (swl_uint32)entry[0], width > 1 ? (swl_uint32)entry[1] : NoSymbol);
+            }
+            XFree(keysyms);
+        }
+    }
+
+    swl_fill_scancodes__x11(APP.platform.keycodes, APP.platform.scancodes);
+}
+
+static swl_bool swl_init__platform(void)
+{
+    APP.platform.display = XOpenDisplay(NULL);
+    if(!APP.platform.display) {
+        SWL_LOG_MESSAGE("X11 display is failed to be opened");
+        return SWL_FALSE;
+    }
+
+    APP.platform.wm_delete_window = XInternAtom(APP.platform.display, "WM_DELETE_WINDOW", False);
+
+    int xkb_major = XkbMajorVersion, xkb_minor = XkbMinorVersion;
+    APP.platform.xkb_available = XkbQueryExtension(APP.platform.display, SWL_NULL, SWL_NULL, SWL_NULL,
+            &xkb_major, &xkb_minor) ? SWL_TRUE : SWL_FALSE;
+    swl_create_key_tables__platform();
+
+#ifdef SWL_USE_XINPUT2
+    swl_select_raw_input__platform();
+#endif
+
+#ifdef SWL_USE_XSHM
+    // Shared pixmaps are not needed, only XShmPutImage
+    APP.platform.shm_available = XShmQueryExtension(APP.platform.display) ? SWL_TRUE : SWL_FALSE;
+    APP.platform.shm_completion_type = XShmGetEventBase(APP.platform.display) + ShmCompletion;
+#endif
+
+    APP.platform.wakeup_fd = swl_create_wakeup_fd__posix();
+
+    return SWL_TRUE;
+}
+
+static void swl_deinit__platform(void)
+{
+    if(APP.platform.wakeup_fd >= 0) close(APP.platform.wakeup_fd);
+    for(swl_uint32 i = 0; i < APP.platform.colormap_count; ++i)
+        XFreeColormap(APP.platform.display, (Colormap)APP.platform.colormaps[i].colormap);
+    swl_free_colormaps__x11();
+    XCloseDisplay(APP.platform.display);
+}
+
+static Colormap swl_get_colormap__platform(Visual *visual)
+{
+    Display *display = APP.platform.display;
+    if(visual == XDefaultVisual(display, XDefaultScreen(display))) return XDefaultColormap(display, XDefaultScreen(display));
+
+    swl_bool is_new;
+    swl_colormap__x11 *slot = swl_colormap_slot__x11((swl_uint32)XVisualIDFromVisual(visual), &is_new);
+    if(!slot) return None;
+    if(is_new) {
+        slot->colormap = (swl_uint32)XCreateColormap(APP.platform.display,
+                XDefaultRootWindow(APP.platform.display), visual, AllocNone);
+    }
+    return (Colormap)slot->colormap;
+}
+
+static swl_bool swl_create_window__platform(swl_window *window, const swl_window_config *config,
+        swl_uint32 visual_id, swl_uint32 depth)
+{
+    Display *display = APP.platform.display;
+    int screen = XDefaultScreen(display);
+    Visual *visual = XDefaultVisual(display, screen);
+    int visual_depth = XDefaultDepth(display, screen);
+    if(visual_id) {
+        XVisualInfo template;
+        template.visualid = (VisualID)visual_id;
+        template.screen = screen;
+        int count = 0;
+        XVisualInfo *info = XGetVisualInfo(display, VisualIDMask | VisualScreenMask, &template, &count);
+        if(!info) {
+            SWL_LOG_MESSAGE("Requested visual is not available on the default screen");
+            return SWL_FALSE;
+        }
+        visual = info->visual;
+        visual_depth = info->depth;
+        XFree(info);
+    }
+    if(depth) visual_depth = (int)depth;
+
+    XSetWindowAttributes swa;
+    swa.override_redirect = True;
+    swa.border_pixel = None;
+    swa.background_pixel = XBlackPixel(display, screen);
+    swa.colormap = swl_get_colormap__platform(visual);
+    if(swa.colormap == None) {
+        SWL_LOG_MESSAGE("Failed to create a colormap for the window visual");
+        return SWL_FALSE;
+    }
+    swa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
+                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
+                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
+                    EnterWindowMask | LeaveWindowMask | PropertyChangeMask;
+
+    Window parent = XDefaultRootWindow(display);
+    Window handle = XCreateWindow(display, parent,
+            0, 0, config->width, config->height, 0,
+            visual_depth, InputOutput,
+            visual,
+            CWBackPixel | CWColormap | CWBorderPixel | CWEventMask,
+            &swa);
+
+    if(!handle) {
+        SWL_LOG_MESSAGE("Failed to create X11 window");
+        return SWL_FALSE;
+    }
+
+    XSetWMProtocols(APP.platform.display, handle, &APP.platform.wm_delete_window, 1);
+
+    window->platform.window = handle;
+    window->platform.visual = visual;
+    window->platform.depth = visual_depth;
+    swl_memset(&window->platform.size_hints, 0, sizeof(window->platform.size_hints));
+
+    return SWL_TRUE;
+}
+
+static swl_uint64 swl_window_key__platform(swl_window *window)
+{
+    return (swl_uint64)window->platform.window;
+}
+
+static swl_window *swl_find_window__platform(Window handle)
+{
+    return swl_window_map_find((swl_uint64)handle);
+}
+
+static void swl_destroy_window__platform(swl_window *window)
+{
+#ifdef SWL_USE_XINPUT2
+    if(APP.platform.focused_window == window) APP.platform.focused_window = SWL_NULL;
+#endif
+    XDestroyWindow(APP.platform.display, window->platform.window);
+}
+
+static void swl_commit_window__platform(swl_window *window)
+{
+    Display *display = APP.platform.display;
+    Window handle = window->platform.window;
+
+    if(window->dirty & SWL_WINDOW_DIRTY_TITLE)
+        XStoreName(display, handle, window->title);
+
+    if(window->dirty & SWL_WINDOW_DIRTY_RESIZABLE) {
+        // Hints are cached on the window so they never have to be read back from the server
+        XSizeHints *hints = &window->platform.size_hints;
+        if(window->is_resizable) {
+            hints->flags &= ~(PMinSize | PMaxSize);
+        } else {
+            hints->flags |= PMinSize | PMaxSize;
+            hints->min_width = hints->max_width = window->width;
+            hints->min_height = hints->max_height = window->height;
+        }
+        XSetWMNormalHints(display, handle, hints);
+    }
+
+    // Mapped last so the window manager sees the final hints
+    if(window->dirty & SWL_WINDOW_DIRTY_VISIBLE) {
+        if(window->is_visible)
+            XMapWindow(display, handle);
+        else
+            XUnmapWindow(display, handle);
+    }
+}
+
+static void swl_flush__platform(void)
+{
+    XFlush(APP.platform.display);
+}
+
+#ifdef SWL_USE_XSHM
+static swl_bool swl_shm_attach_failed;
+
+static int swl_shm_error_handler__platform(Display *display, XErrorEvent *error)
+{
+    (void)display;
+    (void)error;
+    swl_shm_attach_failed = SWL_TRUE;
+    return 0;
+}
+
+static swl_bool swl_create_shared_buffer__platform(swl_framebuffer *framebuffer, int index)
+{
+    Display *display = APP.platform.display;
+    XShmSegmentInfo *shm = &framebuffer->platform.shm[index];
+
+    XImage *image = XShmCreateImage(display, framebuffer->window->platform.visual, (unsigned int)framebuffer->window->platform.depth,
+            ZPixmap, SWL_NULL, shm, framebuffer->width, framebuffer->height);
+    if(!image) return SWL_FALSE;
+    if(image->bits_per_pixel != 32) {
+        XDestroyImage(image);
+        return SWL_FALSE;
+    }
+
+    shm->shmid = shmget(IPC_PRIVATE, (size_t)image->bytes_per_line * (size_t)image->height, IPC_CREAT | 0600);
+    if(shm->shmid < 0) {
+        XDestroyImage(image);
+        return SWL_FALSE;
+    }
+    shm->shmaddr = image->data = (char *)shmat(shm->shmid, SWL_NULL, 0);
+    shm->readOnly = False;
+    if(shm->shmaddr == (char *)-1) {
+        shmctl(shm->shmid, IPC_RMID, SWL_NULL);
+        image->data = SWL_NULL;
+        XDestroyImage(image);
+        return SWL_FALSE;
+    }
+
+    // Attaching fails asynchronously on remote displays, catch the error with a round-trip
+    XSync(display, False);
+    swl_shm_attach_failed = SWL_FALSE;
+    int (*previous_handler)(Display *, XErrorEvent *) = XSetErrorHandler(swl_shm_error_handler__platform);
+    XShmAttach(display, shm);
+    XSync(display, False);
+    XSetErrorHandler(previous_handler);
+
+    // Removed once both sides detach, so the segment can't outlive a crash
+    shmctl(shm->shmid, IPC_RMID, SWL_NULL);
+    if(swl_shm_attach_failed) {
+        shmdt(shm->shmaddr);
+        image->data = SWL_NULL;
+        XDestroyImage(image);
+        return SWL_FALSE;
+    }
+
+    framebuffer->platform.images[index] = image;
+    framebuffer->buffers[index].pixels = image->data;
+    framebuffer->stride = (swl_uint32)image->bytes_per_line;
+    return SWL_TRUE;
+}
+
+static void swl_release_shared_buffer__platform(ShmSeg shmseg)
+{
+    for(swl_framebuffer *framebuffer = APP.framebuffers; framebuffer; framebuffer = framebuffer->next) {
+        if(!framebuffer->is_shared) continue;
+        for(swl_uint32 i = 0; i < framebuffer->buffer_count; ++i) {
+            if(framebuffer->platform.shm[i].shmseg == shmseg) framebuffer->buffers[i].is_busy = SWL_FALSE;
+        }
+    }
+}
+#endif
+
+static swl_bool swl_create_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    Display *display = APP.platform.display;
+
+    if(framebuffer->window->platform.depth != 24) {
+        SWL_LOG_MESSAGE("Framebuffers need a window with a depth 24 visual");
+        return SWL_FALSE;
+    }
+
+    framebuffer->platform.gc = XCreateGC(display, framebuffer->window->platform.window, 0, SWL_NULL);
+
+#ifdef SWL_USE_XSHM
+    if(APP.platform.shm_available) {
+        framebuffer->is_shared = SWL_TRUE;
+        for(int i = 0; i < SWL_FRAMEBUFFER_BUFFER_COUNT; ++i) {
+            if(swl_create_shared_buffer__platform(framebuffer, i)) {
+                framebuffer->buffer_count += 1;
+                continue;
+            }
+            framebuffer->is_shared = i > 0;
+            break;
+        }
+        if(framebuffer->is_shared) return SWL_TRUE;
+        SWL_LOG_MESSAGE("MIT-SHM is unavailable for this display, falling back to XPutImage");
+    }
+#endif
+
+    // XPutImage copies the pixels into the request, one buffer is enough
+    XImage *image = XCreateImage(display, framebuffer->window->platform.visual, (unsigned int)framebuffer->window->platform.depth,
+            ZPixmap, 0, SWL_NULL, framebuffer->width, framebuffer->height, 32, 0);
+    if(!image || image->bits_per_pixel != 32) {
+        SWL_LOG_MESSAGE("Framebuffers need a 32-bit visual");
+        if(image) XDestroyImage(image);
+        XFreeGC(display, framebuffer->platform.gc);
+        return SWL_FALSE;
+    }
+    image->data = (char *)SWL_MALLOC((size_t)image->bytes_per_line * (size_t)image->height);
+    if(!image->data) {
+        SWL_LOG_MESSAGE("Failed to allocate framebuffer pixels");
+        XDestroyImage(image);
+        XFreeGC(display, framebuffer->platform.gc);
+        return SWL_FALSE;
+    }
+
+    framebuffer->platform.images[0] = image;
+    framebuffer->buffers[0].pixels = image->data;
+    framebuffer->buffer_count = 1;
+    framebuffer->stride = (swl_uint32)image->bytes_per_line;
+    return SWL_TRUE;
+}
+
+static void swl_destroy_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    Display *display = APP.platform.display;
+    for(swl_uint32 i = 0; i < framebuffer->buffer_count; ++i) {
+        XImage *image = framebuffer->platform.images[i];
+#ifdef SWL_USE_XSHM
+        if(framebuffer->is_shared) {
+            XShmDetach(display, &framebuffer->platform.shm[i]);
+            shmdt(framebuffer->platform.shm[i].shmaddr);
+        }
+#endif
+        if(!framebuffer->is_shared) SWL_FREE(image->data);
+        // Pixels are released above, XDestroyImage would free() them
+        image->data = SWL_NULL;
+        XDestroyImage(image);
+    }
+    XFreeGC(display, framebuffer->platform.gc);
+    XFlush(display);
+}
+
+static void swl_present_framebuffer__platform(swl_framebuffer *framebuffer, int index,
+        const swl_rect *rects, swl_uint32 rect_count)
+{
+    Display *display = APP.platform.display;
+    Window handle = framebuffer->window->platform.window;
+    XImage *image = framebuffer->platform.images[index];
+    swl_rect whole = { 0, 0, framebuffer->width, framebuffer->height };
+    swl_uint32 count = rect_count ? rect_count : 1;
+    int x, y, width, height;
+
+#ifdef SWL_USE_XSHM
+    if(framebuffer->is_shared) {
+        // Requests run in order, a completion event for the last one releases the whole buffer
+        int last = -1;
+        for(swl_uint32 i = 0; i < count; ++i) {
+            if(swl_clip_framebuffer_rect(framebuffer, rect_count ? &rects[i] : &whole, &x, &y, &width, &height))
+                last = (int)i;
+        }
+        for(swl_uint32 i = 0; last >= 0 && i <= (swl_uint32)last; ++i) {
+            if(!swl_clip_framebuffer_rect(framebuffer, rect_count ? &rects[i] : &whole, &x, &y, &width, &height))
+                continue;
+            XShmPutImage(display, handle, framebuffer->platform.gc, image, x, y, x, y,
+                    (unsigned int)width, (unsigned int)height, i == (swl_uint32)last ? True : False);
+        }
+        if(last >= 0) framebuffer->buffers[index].is_busy = SWL_TRUE;
+        XFlush(display);
+        return;
+    }
+#endif
+
+    for(swl_uint32 i = 0; i < count; ++i) {
+        if(!swl_clip_framebuffer_rect(framebuffer, rect_count ? &rects[i] : &whole, &x, &y, &width, &height))
+            continue;
+        XPutImage(display, handle, framebuffer->platform.gc, image, x, y, x, y,
+                (unsigned int)width, (unsigned int)height);
+    }
+    XFlush(display);
+}
+
+static void swl_translate_event__platform(XEvent *xevent, swl_event_batch *batch)
+{
+    swl_event result;
+    int scancode;
+
+    // HACK: Save scancode as some IMs clear the field in XFilterEvent
+    if (xevent->type == KeyPress || xevent->type == KeyRelease) scancode = xevent->xkey.keycode;
+
+    Bool filtered = False;
+    filtered = XFilterEvent(xevent, None);
+    (void)filtered;
+
+    switch(xevent->type) {
+        case ClientMessage:
+            {
+                if((Atom)xevent->xclient.data.l[0] == APP.platform.wm_delete_window) {
+                    result.type = SWL_EVENT_WINDOW_CLOSED;
+                    result.window.window = swl_find_window__platform(xevent->xclient.window);
+                    swl_event_batch_add(batch, &result);
+                }
+            } break;
+        case KeyPress:
+        case KeyRelease:
+            {
+                if(xevent->type == KeyPress) result.type = SWL_EVENT_KEY_PRESSED;
+                if(xevent->type == KeyRelease) result.type = SWL_EVENT_KEY_RELEASED;
+                result.key.scancode = scancode;
+                result.key.mods = swl_translate_mods__x11(xevent->xkey.state);
+                result.key.keycode = swl_key_translate__x11(APP.platform.keycodes, scancode);
+                result.key.time = SWL_SERVER_TIME(xevent->xkey.time);
+                swl_event_batch_add(batch, &result);
+            } break;
+        case MappingNotify:
+            {
+                XRefreshKeyboardMapping(&xevent->xmapping);
+                if(xevent->xmapping.request == MappingKeyboard) swl_create_key_tables__platform();
+            } break;
+        case ButtonPress:
+        case ButtonRelease:
+            {
+                if(xevent->type == ButtonPress) result.type = SWL_EVENT_MOUSE_BUTTON_PRESSED;
+                else result.type = SWL_EVENT_MOUSE_BUTTON_RELEASED;
+                result.mouse.window = swl_find_window__platform(xevent->xbutton.window);
+                result.mouse.x = xevent->xbutton.x;
+                result.mouse.y = xevent->xbutton.y;
+                result.mouse.button = (int)xevent->xbutton.button;
+                result.mouse.time = SWL_SERVER_TIME(xevent->xbutton.time);
+                swl_event_batch_add(batch, &result);
+            } break;
+        case MotionNotify:
+            {
+                result.type = SWL_EVENT_MOUSE_MOVED;
+                result.mouse.window = swl_find_window__platform(xevent->xmotion.window);
+                result.mouse.x = xevent->xmotion.x;
+                result.mouse.y = xevent->xmotion.y;
+                result.mouse.button = 0;
+                result.mouse.time = SWL_SERVER_TIME(xevent->xmotion.time);
+                swl_event_batch_add(batch, &result);
+            } break;
+#ifdef SWL_USE_XINPUT2
+        case FocusIn:
+            {
+                swl_window *window = swl_find_window__platform(xevent->xfocus.window);
+                if(window) APP.platform.focused_window = window;
+            } break;
+        case FocusOut:
+            {
+                if(APP.platform.focused_window == swl_find_window__platform(xevent->xfocus.window))
+                    APP.platform.focused_window = SWL_NULL;
+            } break;
+        case GenericEvent:
+            {
+                if(xevent->xcookie.extension != APP.platform.xi_opcode) break;
+                if(!XGetEventData(APP.platform.display, &xevent->xcookie)) break;
+                swl_translate_raw_event__platform((const XIRawEvent *)xevent->xcookie.data);
+                XFreeEventData(APP.platform.display, &xevent->xcookie);
+            } break;
+#endif
+        case ConfigureNotify:
+            {
+                swl_window *window = swl_find_window__platform(xevent->xconfigure.window);
+                if(!window) break;
+                swl_event_batch_add_resize(batch, window, xevent->xconfigure.x, xevent->xconfigure.y,
+                        xevent->xconfigure.width, xevent->xconfigure.height);
+            } break;
+        case Expose:
+            {
+                swl_window *window = swl_find_window__platform(xevent->xexpose.window);
+                if(!window) break;
+                swl_event_batch_add_expose(batch, window, xevent->xexpose.x, xevent->xexpose.y,
+                        xevent->xexpose.width, xevent->xexpose.height, xevent->xexpose.count);
+            } break;
+        default:
+            {
+#ifdef SWL_USE_XSHM
+                if(APP.platform.shm_available && xevent->type == APP.platform.shm_completion_type)
+                    swl_release_shared_buffer__platform(((XShmCompletionEvent *)xevent)->shmseg);
+#endif
+            } break;
+    }
+}
+
+void swl_poll_window_events(void)
+{
+    Display *display = APP.platform.display;
+    XEvent xevent;
+    swl_event_batch batch;
+    batch.count = 0;
+    swl_memset(&APP.poll_stats, 0, sizeof(APP.poll_stats));
+    swl_commit_dirty_windows();
+
+    if(APP.poll_mode == SWL_POLL_MODE_PENDING) {
+        for(;;) {
+            // XPending flushes and checks the socket for new data
+            APP.poll_stats.estimated_flushes += 1;
+            APP.poll_stats.estimated_reads += 1;
+            if(XPending(display) <= 0) break;
+
+            XNextEvent(display, &xevent);
+            APP.poll_stats.events_read += 1;
+            swl_translate_event__platform(&xevent, &batch);
+        }
+    } else {
+        XFlush(display);
+        APP.poll_stats.estimated_flushes += 1;
+        if(XQLength(display) == 0) {
+            XEventsQueued(display, QueuedAfterReading);
+            APP.poll_stats.estimated_reads += 1;
+        }
+
+        // XNextEvent does not touch the connection while events are queued
+        while(XQLength(display) > 0) {
+            XNextEvent(display, &xevent);
+            APP.poll_stats.events_read += 1;
+            swl_translate_event__platform(&xevent, &batch);
+        }
+    }
+    swl_event_batch_flush(&batch);
+}
+
+static void swl_wait_events__platform(swl_bool has_timeout, swl_uint64 timeout_ns)
+{
+    Display *display = APP.platform.display;
+    // Pending changes such as mapping the window may be what produces the next event
+    swl_commit_dirty_windows();
+    XFlush(display);
+
+    // Events Xlib has already read from the socket would never wake up poll()
+    if(XQLength(display) == 0) {
+        swl_wait_for_connection__posix(ConnectionNumber(display), APP.platform.wakeup_fd,
+                has_timeout, timeout_ns);
+    }
+
+    swl_poll_window_events();
+}
+
+void swl_wait_events(void)
+{
+    swl_wait_events__platform(SWL_FALSE, 0);
+}
+
+void swl_wait_events_timeout(swl_uint64 timeout_ns)
+{
+    swl_wait_events__platform(SWL_TRUE, timeout_ns);
+}
+
+void swl_post_empty_event(void)
+{
+    if(APP.platform.wakeup_fd >= 0) eventfd_write(APP.platform.wakeup_fd, 1);
+}
+
+Display *swl_x11_get_display(void)
+{
+    return APP.platform.display;
+}
+
+Window swl_x11_get_window(swl_window *window)
+{
+    return window->platform.window;
+}
+
+#endif // SWL_DISPLAY_X11
+
+#ifdef SWL_DISPLAY_XCB
+static swl_uint32 swl_strlen(const char *string)
+{
+    swl_uint32 length = 0;
+    while(string[length]) ++length;
+    return length;
+}
+
+static void swl_create_key_tables__platform(xcb_get_keyboard_mapping_cookie_t cookie)
+{
+    const xcb_setup_t *setup = xcb_get_setup(APP.platform.connection);
+    swl_reset_key_tables__x11(APP.platform.keycodes, APP.platform.scancodes);
+
+    xcb_get_keyboard_mapping_reply_t *reply = xcb_get_keyboard_mapping_reply(APP.platform.connection, cookie, SWL_NULL);
+    if(!reply) {
+        SWL_LOG_MESSAGE("Failed to get the XCB keyboard mapping");
+        return;
+    }
+
+    xcb_keysym_t *keysyms = xcb_get_keyboard_mapping_keysyms(reply);
+    int width = reply->keysyms_per_keycode;
+    for(int scancode = setup->min_keycode; width > 0 && scancode <= setup->max_keycode; ++scancode) {
+        xcb_keysym_t *entry = &keysyms[(scancode - setup->min_keycode) * width];
+        APP.platform.keycodes[scancode] = swl_translate_keysyms__x11(entry[0], width > 1 ? entry[1] : XCB_NO_SYMBOL);
+    }
+    free(reply);
+
+    swl_fill_scancodes__x11(APP.platform.keycodes, APP.platform.scancodes);
+}
+
+#define SWL_SERVER_TIME(time) \
+    swl_server_time_to_ns__x11(&APP.platform.server_time, &APP.platform.server_time_high, (swl_uint32)(time))
+
+static xcb_get_keyboard_mapping_cookie_t swl_request_key_tables__platform(void)
+{
+    const xcb_setup_t *setup = xcb_get_setup(APP.platform.connection);
+    return xcb_get_keyboard_mapping(APP.platform.connection, setup->min_keycode,
+            (uint8_t)(setup->max_keycode - setup->min_keycode + 1));
+}
+
+static swl_bool swl_init__platform(void)
+{
+    int screen_index = 0;
+    APP.platform.connection = xcb_connect(SWL_NULL, &screen_index);
+    if(xcb_connection_has_error(APP.platform.connection)) {
+        SWL_LOG_MESSAGE("XCB connection is failed to be opened");
+        xcb_disconnect(APP.platform.connection);
+        return SWL_FALSE;
+    }
+
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(APP.platform.connection));
+    for(; screens.rem > 1 && screen_index > 0; --screen_index) xcb_screen_next(&screens);
+    APP.platform.screen = screens.data;
+
+    // Send every intern and keyboard mapping request before waiting on the first reply
+    static const char *atom_names[SWL_XCB_ATOM_COUNT] = {
+        "WM_PROTOCOLS",
+        "WM_DELETE_WINDOW",
+        "_NET_WM_NAME",
+        "UTF8_STRING",
+    };
+    xcb_intern_atom_cookie_t cookies[SWL_XCB_ATOM_COUNT];
+    for(swl_uint32 i = 0; i < SWL_XCB_ATOM_COUNT; ++i) {
+        cookies[i] = xcb_intern_atom(APP.platform.connection, 0,
+                (uint16_t)swl_strlen(atom_names[i]), atom_names[i]);
+    }
+    xcb_get_keyboard_mapping_cookie_t keyboard_cookie = swl_request_key_tables__platform();
+    for(swl_uint32 i = 0; i < SWL_XCB_ATOM_COUNT; ++i) {
+        xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(APP.platform.connection, cookies[i], SWL_NULL);
+        APP.platform.atoms[i] = reply ? reply->atom : XCB_ATOM_NONE;
+        free(reply);
+    }
+    swl_create_key_tables__platform(keyboard_cookie);
+
+    APP.platform.wakeup_fd = swl_create_wakeup_fd__posix();
+    APP.platform.pending_event = SWL_NULL;
+
+    return SWL_TRUE;
+}
+
+static void swl_deinit__platform(void)
+{
+    free(APP.platform.pending_event);
+    APP.platform.pending_event = SWL_NULL;
+    if(APP.platform.wakeup_fd >= 0) close(APP.platform.wakeup_fd);
+    for(swl_uint32 i = 0; i < APP.platform.colormap_count; ++i)
+        xcb_free_colormap(APP.platform.connection, APP.platform.colormaps[i].colormap);
+    swl_free_colormaps__x11();
+    xcb_disconnect(APP.platform.connection);
+}
+
+static swl_uint8 swl_visual_depth__platform(xcb_visualid_t visual)
+{
+    xcb_depth_iterator_t depths = xcb_screen_allowed_depths_iterator(APP.platform.screen);
+    for(; depths.rem; xcb_depth_next(&depths)) {
+        xcb_visualtype_iterator_t visuals = xcb_depth_visuals_iterator(depths.data);
+        for(; visuals.rem; xcb_visualtype_next(&visuals)) {
+            if(visuals.data->visual_id == visual) return depths.data->depth;
+        }
+    }
+    return 0;
+}
+
+static xcb_colormap_t swl_get_colormap__platform(xcb_visualid_t visual)
+{
+    if(visual == APP.platform.screen->root_visual) return APP.platform.screen->default_colormap;
+
+    swl_bool is_new;
+    swl_colormap__x11 *slot = swl_colormap_slot__x11(visual, &is_new);
+    if(!slot) return XCB_NONE;
+    if(is_new) {
+        slot->colormap = xcb_generate_id(APP.platform.connection);
+        xcb_create_colormap(APP.platform.connection, XCB_COLORMAP_ALLOC_NONE, slot->colormap,
+                APP.platform.screen->root, visual);
+    }
+    return slot->colormap;
+}
+
+static swl_bool swl_create_window__platform(swl_window *window, const swl_window_config *config,
+        swl_uint32 visual_id, swl_uint32 depth)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+    xcb_screen_t *screen = APP.platform.screen;
+
+    xcb_visualid_t visual = visual_id ? visual_id : screen->root_visual;
+    swl_uint8 visual_depth = depth ? (swl_uint8)depth : swl_visual_depth__platform(visual);
+    if(!visual_depth) {
+        SWL_LOG_MESSAGE("Requested visual is not available on the default screen");
+        return SWL_FALSE;
+    }
+
+    // Values are ordered by their bit in the value mask
+    uint32_t values[4];
+    values[0] = screen->black_pixel;
+    values[1] = 0;
+    values[2] = XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE |
+                XCB_EVENT_MASK_POINTER_MOTION | XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE |
+                XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_FOCUS_CHANGE | XCB_EVENT_MASK_VISIBILITY_CHANGE |
+                XCB_EVENT_MASK_ENTER_WINDOW | XCB_EVENT_MASK_LEAVE_WINDOW | XCB_EVENT_MASK_PROPERTY_CHANGE;
+    values[3] = swl_get_colormap__platform(visual);
+    if(values[3] == XCB_NONE) {
+        SWL_LOG_MESSAGE("Failed to create a colormap for the window visual");
+        return SWL_FALSE;
+    }
+
+    xcb_window_t handle = xcb_generate_id(connection);
+    if(handle == (xcb_window_t)-1) {
+        SWL_LOG_MESSAGE("Failed to create XCB window");
+        return SWL_FALSE;
+    }
+
+    // Errors are reported asynchronously through the event pump
+    xcb_create_window(connection, visual_depth, handle, screen->root,
+            0, 0, config->width, config->height, 0,
+            XCB_WINDOW_CLASS_INPUT_OUTPUT, visual,
+            XCB_CW_BACK_PIXEL | XCB_CW_BORDER_PIXEL | XCB_CW_EVENT_MASK | XCB_CW_COLORMAP,
+            values);
+
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, handle,
+            APP.platform.atoms[SWL_XCB_ATOM_WM_PROTOCOLS], XCB_ATOM_ATOM, 32, 1,
+            &APP.platform.atoms[SWL_XCB_ATOM_WM_DELETE_WINDOW]);
+
+    window->platform.window = handle;
+    window->platform.depth = visual_depth;
+
+    return SWL_TRUE;
+}
+
+static swl_uint64 swl_window_key__platform(swl_window *window)
+{
+    return (swl_uint64)window->platform.window;
+}
+
+static swl_window *swl_find_window__platform(xcb_window_t handle)
+{
+    return swl_window_map_find((swl_uint64)handle);
+}
+
+static void swl_destroy_window__platform(swl_window *window)
+{
+    xcb_destroy_window(APP.platform.connection, window->platform.window);
+    xcb_flush(APP.platform.connection);
+}
+
+static void swl_commit_window__platform(swl_window *window)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+    xcb_window_t handle = window->platform.window;
+
+    if(window->dirty & SWL_WINDOW_DIRTY_TITLE) {
+        swl_uint32 length = swl_strlen(window->title);
+        xcb_change_property(connection, XCB_PROP_MODE_REPLACE, handle,
+                XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, length, window->title);
+        xcb_change_property(connection, XCB_PROP_MODE_REPLACE, handle,
+                APP.platform.atoms[SWL_XCB_ATOM_NET_WM_NAME], APP.platform.atoms[SWL_XCB_ATOM_UTF8_STRING],
+                8, length, window->title);
+    }
+
+    if(window->dirty & SWL_WINDOW_DIRTY_RESIZABLE) {
+        // WM_SIZE_HINTS layout from ICCCM: flags, 4 obsolete fields, min, max, increments, aspects, base, gravity
+        enum { SWL_XCB_HINT_MIN_SIZE = 1 << 4, SWL_XCB_HINT_MAX_SIZE = 1 << 5 };
+        uint32_t hints[18];
+        swl_memset(hints, 0, sizeof(hints));
+        if(!window->is_resizable) {
+            hints[0] = SWL_XCB_HINT_MIN_SIZE | SWL_XCB_HINT_MAX_SIZE;
+            hints[5] = hints[7] = window->width;
+            hints[6] = hints[8] = window->height;
+        }
+        xcb_change_property(connection, XCB_PROP_MODE_REPLACE, handle,
+                XCB_ATOM_WM_NORMAL_HINTS, XCB_ATOM_WM_SIZE_HINTS, 32, 18, hints);
+    }
+
+    // Mapped last so the window manager sees the final hints
+    if(window->dirty & SWL_WINDOW_DIRTY_VISIBLE) {
+        if(window->is_visible)
+            xcb_map_window(connection, handle);
+        else
+            xcb_unmap_window(connection, handle);
+    }
+}
+
+static void swl_flush__platform(void)
+{
+    xcb_flush(APP.platform.connection);
+}
+
+static void swl_translate_event__platform(xcb_generic_event_t *event, swl_event_batch *batch)
+{
+    swl_event result;
+
+    switch(event->response_type & ~0x80) {
+        case 0:
+            {
+                SWL_LOG_MESSAGE("XCB request failed");
+            } break;
+        case XCB_CLIENT_MESSAGE:
+            {
+                xcb_client_message_event_t *message = (xcb_client_message_event_t *)event;
+                if(message->type == APP.platform.atoms[SWL_XCB_ATOM_WM_PROTOCOLS] &&
+                        message->data.data32[0] == APP.platform.atoms[SWL_XCB_ATOM_WM_DELETE_WINDOW]) {
+                    result.type = SWL_EVENT_WINDOW_CLOSED;
+                    result.window.window = swl_find_window__platform(message->window);
+                    swl_event_batch_add(batch, &result);
+                }
+            } break;
+        case XCB_KEY_PRESS:
+        case XCB_KEY_RELEASE:
+            {
+                xcb_key_press_event_t *key = (xcb_key_press_event_t *)event;
+                if((event->response_type & ~0x80) == XCB_KEY_PRESS) result.type = SWL_EVENT_KEY_PRESSED;
+                else result.type = SWL_EVENT_KEY_RELEASED;
+                result.key.scancode = key->detail;
+                result.key.keycode = swl_key_translate__x11(APP.platform.keycodes, key->detail);
+                result.key.mods = swl_translate_mods__x11(key->state);
+                result.key.time = SWL_SERVER_TIME(key->time);
+                swl_event_batch_add(batch, &result);
+            } break;
+        case XCB_MAPPING_NOTIFY:
+            {
+                xcb_mapping_notify_event_t *mapping = (xcb_mapping_notify_event_t *)event;
+                if(mapping->request == XCB_MAPPING_KEYBOARD)
+                    swl_create_key_tables__platform(swl_request_key_tables__platform());
+            } break;
+        case XCB_BUTTON_PRESS:
+        case XCB_BUTTON_RELEASE:
+            {
+                xcb_button_press_event_t *button = (xcb_button_press_event_t *)event;
+                if((event->response_type & ~0x80) == XCB_BUTTON_PRESS) result.type = SWL_EVENT_MOUSE_BUTTON_PRESSED;
+                else result.type = SWL_EVENT_MOUSE_BUTTON_RELEASED;
+                result.mouse.window = swl_find_window__platform(button->event);
+                result.mouse.x = button->event_x;
+                result.mouse.y = button->event_y;
+                result.mouse.button = button->detail;
+                result.mouse.time = SWL_SERVER_TIME(button->time);
+                swl_event_batch_add(batch, &result);
+            } break;
+        case XCB_MOTION_NOTIFY:
+            {
+                xcb_motion_notify_event_t *motion = (xcb_motion_notify_event_t *)event;
+                result.type = SWL_EVENT_MOUSE_MOVED;
+                result.mouse.window = swl_find_window__platform(motion->event);
+                result.mouse.x = motion->event_x;
+                result.mouse.y = motion->event_y;
+                result.mouse.button = 0;
+                result.mouse.time = SWL_SERVER_TIME(motion->time);
+                swl_event_batch_add(batch, &result);
+            } break;
+        case XCB_CONFIGURE_NOTIFY:
+            {
+                xcb_configure_notify_event_t *configure = (xcb_configure_notify_event_t *)event;
+                swl_window *window = swl_find_window__platform(configure->window);
+                if(!window) break;
+                swl_event_batch_add_resize(batch, window, configure->x, configure->y,
+                        configure->width, configure->height);
+            } break;
+        case XCB_EXPOSE:
+            {
+                xcb_expose_event_t *expose = (xcb_expose_event_t *)event;
+                swl_window *window = swl_find_window__platform(expose->window);
+                if(!window) break;
+                swl_event_batch_add_expose(batch, window, expose->x, expose->y,
+                        expose->width, expose->height, expose->count);
+            } break;
+        default:
+            break;
+    }
+}
+
+void swl_poll_window_events(void)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+    swl_event_batch batch;
+    batch.count = 0;
+    swl_memset(&APP.poll_stats, 0, sizeof(APP.poll_stats));
+    swl_commit_dirty_windows();
+
+    xcb_flush(connection);
+    APP.poll_stats.estimated_flushes += 1;
+
+    xcb_generic_event_t *event = APP.platform.pending_event;
+    APP.platform.pending_event = SWL_NULL;
+    if(!event) {
+        // Reads the socket only when nothing is queued yet
+        event = xcb_poll_for_event(connection);
+        APP.poll_stats.estimated_reads += 1;
+    }
+
+    while(event) {
+        APP.poll_stats.events_read += 1;
+        swl_translate_event__platform(event, &batch);
+        free(event);
+
+        if(APP.poll_mode == SWL_POLL_MODE_PENDING) {
+            event = xcb_poll_for_event(connection);
+            APP.poll_stats.estimated_reads += 1;
+        } else {
+            event = xcb_poll_for_queued_event(connection);
+        }
+    }
+    swl_event_batch_flush(&batch);
+}
+
+static void swl_wait_events__platform(swl_bool has_timeout, swl_uint64 timeout_ns)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+    // Pending changes such as mapping the window may be what produces the next event
+    swl_commit_dirty_windows();
+    xcb_flush(connection);
+
+    // Events xcb has already read from the socket would never wake up poll()
+    if(!APP.platform.pending_event)
+        APP.platform.pending_event = xcb_poll_for_queued_event(connection);
+    if(!APP.platform.pending_event) {
+        swl_wait_for_connection__posix(xcb_get_file_descriptor(connection), APP.platform.wakeup_fd,
+                has_timeout, timeout_ns);
+    }
+
+    swl_poll_window_events();
+}
+
+void swl_wait_events(void)
+{
+    swl_wait_events__platform(SWL_FALSE, 0);
+}
+
+void swl_wait_events_timeout(swl_uint64 timeout_ns)
+{
+    swl_wait_events__platform(SWL_TRUE, timeout_ns);
+}
+
+void swl_post_empty_event(void)
+{
+    if(APP.platform.wakeup_fd >= 0) eventfd_write(APP.platform.wakeup_fd, 1);
+}
+
+static swl_bool swl_create_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+
+    if(framebuffer->window->platform.depth != 24) {
+        SWL_LOG_MESSAGE("Framebuffers need a window with a depth 24 visual");
+        return SWL_FALSE;
+    }
+
+    // Rows are only tightly packed when the window depth is stored in 32 bits per pixel
+    swl_bool has_format = SWL_FALSE;
+    xcb_format_iterator_t formats = xcb_setup_pixmap_formats_iterator(xcb_get_setup(connection));
+    for(; formats.rem; xcb_format_next(&formats)) {
+        if(formats.data->depth == framebuffer->window->platform.depth && formats.data->bits_per_pixel == 32) has_format = SWL_TRUE;
+    }
+    if(!has_format) {
+        SWL_LOG_MESSAGE("Framebuffers need a 32-bit visual");
+        return SWL_FALSE;
+    }
+
+    // xcb_put_image copies the pixels into the request, one buffer is enough
+    framebuffer->stride = framebuffer->width * 4;
+    framebuffer->buffers[0].pixels = SWL_MALLOC((size_t)framebuffer->stride * framebuffer->height);
+    if(!framebuffer->buffers[0].pixels) {
+        SWL_LOG_MESSAGE("Failed to allocate framebuffer pixels");
+        return SWL_FALSE;
+    }
+    framebuffer->buffer_count = 1;
+
+    framebuffer->platform.gc = xcb_generate_id(connection);
+    xcb_create_gc(connection, framebuffer->platform.gc, framebuffer->window->platform.window, 0, SWL_NULL);
+    return SWL_TRUE;
+}
+
+static void swl_destroy_framebuffer__platform(swl_framebuffer *framebuffer)
+{
+    xcb_free_gc(APP.platform.connection, framebuffer->platform.gc);
+    xcb_flush(APP.platform.connection);
+    SWL_FREE(framebuffer->buffers[0].pixels);
+}
+
+static void swl_present_framebuffer__platform(swl_framebuffer *framebuffer, int index,
+        const swl_rect *rects, swl_uint32 rect_count)
+{
+    xcb_connection_t *connection = APP.platform.connection;
+    const swl_uint8 *pixels = (const swl_uint8 *)framebuffer->buffers[index].pixels;
+    swl_rect whole = { 0, 0, framebuffer->width, framebuffer->height };
+    swl_uint32 count = rect_count ? rect_count : 1;
+    int x, y, width, height;
+
+    // Requests are capped at the maximum request length, the PutImage header takes 24 bytes
+    swl_uint32 max_rows = (xcb_get_maximum_request_length(connection) * 4 - 24) / framebuffer->stride;
+    if(max_rows == 0) max_rows = 1;
+
+    for(swl_uint32 i = 0; i < count; ++i) {
+        if(!swl_clip_framebuffer_rect(framebuffer, rect_count ? &rects[i] : &whole, &x, &y, &width, &height))
+            continue;
+        // Whole rows are contiguous, sending full-width bands avoids repacking the rectangle
+        for(swl_uint32 row = (swl_uint32)y; row < (swl_uint32)(y + height); row += max_rows) {
+            swl_uint32 rows = (swl_uint32)(y + height) - row;
+            if(rows > max_rows) rows = max_rows;
+            xcb_put_image(connection, XCB_IMAGE_FORMAT_Z_PIXMAP, framebuffer->window->platform.window,
+                    framebuffer->platform.gc, (uint16_t)framebuffer->width, (uint16_t)rows, 0, (int16_t)row,
+                    0, framebuffer->window->platform.depth, rows * framebuffer->stride, pixels + row * framebuffer->stride);
+        }
+    }
+    xcb_flush(connection);
+}
+
+xcb_connection_t *swl_xcb_get_connection(void)
+{
+    return APP.platform.connection;
+}
+
+swl_uint32 swl_xcb_get_window(swl_window *window)
+{
+    return window->platform.window;
+}
+
+#endif // SWL_DISPLAY_XCB
+
+swl_bool swl_init(void)
+{
+    if(APP.initialized) {
+        SWL_LOG_MESSAGE("Application is already initialized");
         return SWL_FALSE;
     }
 
-    for(swl_uint32 i = 0; i < SWL_MAXIMUM_WINDOW_CREATED; ++i) {
-        APP.windows[i].initialized = SWL_FALSE;
+    if(!swl_init__platform()) {
+        SWL_LOG_MESSAGE("Failed to initialize platform spesific data of application");
+        return SWL_FALSE;
     }
 
+    APP.initialized = SWL_TRUE;
     return SWL_TRUE;
 }
 
@@ -623,20 +2632,20 @@ void swl_deinit(void)
 {
     if(!APP.initialized) return;
     swl_deinit__platform();
+    swl_window_pool_deinit();
+    APP.initialized = SWL_FALSE;
 }
 
 swl_window *swl_create_window(const swl_window_config *config)
 {
-    swl_window *window = 0;
-    for(swl_uint32 i = 0; i < SWL_MAXIMUM_WINDOW_CREATED; ++i) {
-        if(!APP.windows[i].initialized) {
-            window = &APP.windows[i];
-            break;
-        }
-    }
+    return swl_create_window_with_visual(config, 0, 0);
+}
 
+swl_window *swl_create_window_with_visual(const swl_window_config *config, swl_uint32 visual_id, swl_uint32 depth)
+{
+    swl_window *window = swl_window_pool_acquire();
     if(!window) {
-        SWL_LOG_MESSAGE("Could not create window more than SWL_MAXIMUM_WINDOW_CREATED");
+        SWL_LOG_MESSAGE("Failed to allocate a window");
         return SWL_NULL;
     }
 
@@ -654,58 +2663,386 @@ swl_window *swl_create_window(const swl_window_config *config)
         real_config.is_visible = config->is_visible;
     }
 
-    if(!swl_create_window__platform(window, &real_config)) {
+    window->width = real_config.width;
+    window->height = real_config.height;
+    if(!swl_create_window__platform(window, &real_config, visual_id, depth)) {
         SWL_LOG_MESSAGE("Failed to initialize the platform spesific data of window");
+        swl_window_pool_release(window);
+        return SWL_NULL;
+    }
+
+    if(!swl_window_map_insert(swl_window_key__platform(window), window)) {
+        swl_destroy_window__platform(window);
+        swl_window_pool_release(window);
         return SWL_NULL;
     }
 
     window->initialized = SWL_TRUE;
 
-    swl_set_window_title(window, config->title);
-    swl_set_window_visible(window, config->is_visible);
-    swl_set_window_resizable(window, config->is_resizable);
+    // Sent along with the first poll instead of one round-trip per property
+    swl_set_window_title(window, real_config.title);
+    swl_set_window_visible(window, real_config.is_visible);
+    swl_set_window_resizable(window, real_config.is_resizable);
     return window;
 }
 
 void swl_destroy_window(swl_window *window)
 {
+    if(!window) return;
+    swl_window_map_remove(swl_window_key__platform(window));
     swl_destroy_window__platform(window);
-    window->initialized = SWL_FALSE;
+    swl_window_pool_release(window);
 }
 
-swl_bool swl_push_event(swl_event event)
+void swl_set_window_title(swl_window *window, const char *title)
 {
-    unsigned int index = APP.event_queue.head;
-    if(APP.event_queue.head + 1 > SWL_EVENT_QUEUE_CAPACITY) {
-        if(APP.event_queue.carry) {
-            return SWL_FALSE; // Event queue is full
+    if(!window) {
+        SWL_LOG_MESSAGE("Invalid window at swl_set_window_title");
+        return;
+    }
+
+    swl_uint32 length = 0;
+    if(title) {
+        while(title[length] && length + 1 < SWL_WINDOW_TITLE_CAPACITY) {
+            window->title[length] = title[length];
+            ++length;
         }
-        APP.event_queue.carry = SWL_TRUE;
-        APP.event_queue.head = 0;
-    } else {
-        APP.event_queue.head += 1;
     }
+    window->title[length] = '\0';
+    window->dirty |= SWL_WINDOW_DIRTY_TITLE;
+}
+
+void swl_set_window_visible(swl_window *window, swl_bool is_visible)
+{
+    if(!window) {
+        SWL_LOG_MESSAGE("Invalid window passed at swl_set_window_visible");
+        return;
+    }
+
+    window->is_visible = is_visible;
+    window->dirty |= SWL_WINDOW_DIRTY_VISIBLE;
+}
+
+void swl_set_window_resizable(swl_window *window, swl_bool is_resizable)
+{
+    if(!window) {
+        SWL_LOG_MESSAGE("Invalid window passed at swl_set_window_resizable");
+        return;
+    }
+
+    window->is_resizable = is_resizable;
+    window->dirty |= SWL_WINDOW_DIRTY_RESIZABLE;
+}
+
+void swl_commit_window(swl_window *window)
+{
+    if(!window) {
+        SWL_LOG_MESSAGE("Invalid window passed at swl_commit_window");
+        return;
+    }
+
+    if(window->dirty) {
+        swl_commit_window__platform(window);
+        window->dirty = 0;
+    }
+    swl_flush__platform();
+}
+
+static void swl_event_queue_write(swl_uint32 start, const swl_event *events, swl_uint32 count)
+{
+    swl_uint32 offset = start & SWL_EVENT_QUEUE_MASK;
+    swl_uint32 first = SWL_EVENT_QUEUE_CAPACITY - offset;
+    if(first > count) first = count;
+    swl_memcpy(&APP.event_queue.items[offset], events, first * sizeof(*events));
+    swl_memcpy(&APP.event_queue.items[0], events + first, (count - first) * sizeof(*events));
+}
+
+static void swl_event_queue_read(swl_uint32 start, swl_event *events, swl_uint32 count)
+{
+    swl_uint32 offset = start & SWL_EVENT_QUEUE_MASK;
+    swl_uint32 first = SWL_EVENT_QUEUE_CAPACITY - offset;
+    if(first > count) first = count;
+    swl_memcpy(events, &APP.event_queue.items[offset], first * sizeof(*events));
+    swl_memcpy(events + first, &APP.event_queue.items[0], (count - first) * sizeof(*events));
+}
+
+// Reserve up to count published slots for reading, returns how many were reserved
+static swl_uint32 swl_event_queue_acquire(swl_uint32 count, swl_uint32 *start)
+{
+    swl_uint32 head = swl_atomic_load(&APP.event_queue.consumer.head);
+    swl_uint32 available;
+    for(;;) {
+        available = swl_atomic_load(&APP.event_queue.producer.tail) - head;
+        if(available == 0) return 0; // Event queue is empty
+        if(available > count) available = count;
+        if(swl_atomic_cas(&APP.event_queue.consumer.head, &head, head + available)) break;
+    }
+    *start = head;
+    return available;
+}
+
+// Events the calling thread peeked and hasn't released yet. Slots are released
+// in reservation order, so a later reservation on the same thread could never
+// be released and shifting or peeking again would spin forever.
+static SWL_THREAD_LOCAL swl_uint32 swl_peeked_event_count = 0;
 
-    APP.event_queue.items[index] = event;
+static swl_bool swl_event_queue_is_peeked(const char *function)
+{
+    if(!swl_peeked_event_count) return SWL_FALSE;
+    SWL_LOG_MESSAGE(function);
     return SWL_TRUE;
 }
 
+static void swl_event_queue_release(swl_uint32 start, swl_uint32 count)
+{
+    // Release the slots back to the producer in reservation order
+    while(swl_atomic_load(&APP.event_queue.consumer.tail) != start) swl_cpu_relax();
+    swl_atomic_store(&APP.event_queue.consumer.tail, start + count);
+}
+
+swl_uint32 swl_push_events(const swl_event *events, swl_uint32 count)
+{
+    if(!count) return 0;
+
+    swl_uint32 head = swl_atomic_load(&APP.event_queue.producer.head);
+    swl_uint32 reserved;
+    for(;;) {
+        swl_uint32 tail = swl_atomic_load(&APP.event_queue.consumer.tail);
+        reserved = SWL_EVENT_QUEUE_CAPACITY - (head - tail);
+        if(reserved > count) reserved = count;
+        if(reserved == 0) break; // Event queue is full
+#ifdef SWL_EVENT_QUEUE_MULTI_PRODUCER
+        if(swl_atomic_cas(&APP.event_queue.producer.head, &head, head + reserved)) break;
+#else
+        APP.event_queue.producer.head = head + reserved;
+        break;
+#endif
+    }
+
+    if(reserved < count)
+        swl_atomic_add(&APP.event_queue.overflow_count, count - reserved);
+    if(!reserved) return 0;
+
+    swl_event_queue_write(head, events, reserved);
+
+#ifdef SWL_EVENT_QUEUE_MULTI_PRODUCER
+    // Publish in reservation order so consumers never see a hole
+    while(swl_atomic_load(&APP.event_queue.producer.tail) != head) swl_cpu_relax();
+#endif
+    swl_atomic_store(&APP.event_queue.producer.tail, head + reserved);
+    return reserved;
+}
+
+swl_uint32 swl_shift_events(swl_event *events, swl_uint32 count)
+{
+    if(swl_event_queue_is_peeked("Release the peeked events before swl_shift_events")) return 0;
+
+    swl_uint32 start;
+    swl_uint32 acquired = swl_event_queue_acquire(count, &start);
+    if(!acquired) return 0;
+
+    swl_event_queue_read(start, events, acquired);
+    swl_event_queue_release(start, acquired);
+    return acquired;
+}
+
+swl_uint32 swl_peek_events(swl_event_span *span, swl_uint32 count)
+{
+    if(swl_event_queue_is_peeked("Release the peeked events before swl_peek_events again")) {
+        swl_memset(span, 0, sizeof(*span));
+        return 0;
+    }
+
+    swl_uint32 start = 0;
+    swl_uint32 acquired = swl_event_queue_acquire(count, &start);
+    swl_uint32 offset = start & SWL_EVENT_QUEUE_MASK;
+    swl_uint32 first = SWL_EVENT_QUEUE_CAPACITY - offset;
+    if(first > acquired) first = acquired;
+
+    span->first = &APP.event_queue.items[offset];
+    span->first_count = first;
+    span->second = &APP.event_queue.items[0];
+    span->second_count = acquired - first;
+    span->start = start;
+    swl_peeked_event_count = acquired;
+    return acquired;
+}
+
+void swl_release_events(const swl_event_span *span)
+{
+    swl_uint32 count = span->first_count + span->second_count;
+    if(!count) return;
+    swl_event_queue_release(span->start, count);
+    swl_peeked_event_count = 0;
+}
+
+swl_bool swl_push_event(swl_event event)
+{
+    return swl_push_events(&event, 1) == 1;
+}
+
 swl_bool swl_shift_event(swl_event *event)
 {
-    unsigned int index = APP.event_queue.tail;
-    if(APP.event_queue.tail + 1 > APP.event_queue.head) return SWL_FALSE;
-    if(APP.event_queue.tail + 1 > SWL_EVENT_QUEUE_CAPACITY) {
-        if(!APP.event_queue.carry) {
-            return SWL_FALSE; // Event queue is empty
+    return swl_shift_events(event, 1) == 1;
+}
+
+void swl_set_event_coalescing(swl_bool is_enabled)
+{
+    APP.coalesce_events = is_enabled;
+}
+
+void swl_get_poll_stats(swl_poll_stats *stats)
+{
+    *stats = APP.poll_stats;
+}
+
+void swl_set_poll_mode(swl_poll_mode mode)
+{
+    APP.poll_mode = mode;
+}
+
+swl_uint32 swl_get_event_overflow_count(void)
+{
+    return swl_atomic_load(&APP.event_queue.overflow_count);
+}
+
+swl_bool swl_get_raw_mouse_delta(double *dx, double *dy, swl_uint64 *time)
+{
+    *dx = APP.raw_motion.dx;
+    *dy = APP.raw_motion.dy;
+    *time = APP.raw_motion.time;
+    APP.raw_motion.dx = 0.0;
+    APP.raw_motion.dy = 0.0;
+    return APP.raw_motion.is_available;
+}
+
+swl_framebuffer *swl_create_framebuffer(swl_window *window, swl_uint32 width, swl_uint32 height)
+{
+    if(!window || width == 0 || height == 0) {
+        SWL_LOG_MESSAGE("Invalid arguments passed at swl_create_framebuffer");
+        return SWL_NULL;
+    }
+
+    swl_framebuffer *framebuffer = (swl_framebuffer *)SWL_MALLOC(sizeof(*framebuffer));
+    if(!framebuffer) {
+        SWL_LOG_MESSAGE("Failed to allocate a framebuffer");
+        return SWL_NULL;
+    }
+    swl_memset(framebuffer, 0, sizeof(*framebuffer));
+    framebuffer->window = window;
+    framebuffer->width = width;
+    framebuffer->height = height;
+    framebuffer->acquired = -1;
+    framebuffer->front = -1;
+
+    if(!swl_create_framebuffer__platform(framebuffer)) {
+        SWL_FREE(framebuffer);
+        return SWL_NULL;
+    }
+
+    framebuffer->next = APP.framebuffers;
+    APP.framebuffers = framebuffer;
+    return framebuffer;
+}
+
+void swl_destroy_framebuffer(swl_framebuffer *framebuffer)
+{
+    if(!framebuffer) return;
+    for(swl_framebuffer **link = &APP.framebuffers; *link; link = &(*link)->next) {
+        if(*link == framebuffer) {
+            *link = framebuffer->next;
+            break;
         }
-        APP.event_queue.carry = SWL_FALSE;
-        APP.event_queue.tail = 0;
-    } else {
-        APP.event_queue.tail += 1;
     }
+    swl_destroy_framebuffer__platform(framebuffer);
+    SWL_FREE(framebuffer);
+}
 
-    *event = APP.event_queue.items[index];
-    return SWL_TRUE;
+void *swl_acquire_framebuffer(swl_framebuffer *framebuffer, swl_uint32 *stride, swl_bool should_wait)
+{
+    if(!framebuffer) {
+        SWL_LOG_MESSAGE("Invalid framebuffer passed at swl_acquire_framebuffer");
+        return SWL_NULL;
+    }
+
+    if(framebuffer->acquired < 0) {
+        int index = -1;
+        for(;;) {
+            // Starting after the front buffer leaves it to the server as long as possible
+            for(swl_uint32 i = 1; i <= framebuffer->buffer_count && index < 0; ++i) {
+                int candidate = (framebuffer->front + (int)i) % (int)framebuffer->buffer_count;
+                if(!framebuffer->buffers[candidate].is_busy) index = candidate;
+            }
+            if(index >= 0 || !should_wait) break;
+            swl_wait_events();
+        }
+        if(index < 0) return SWL_NULL;
+
+        // Bring the buffer up to date with what was presented from the others
+        swl_framebuffer_buffer *buffer = &framebuffer->buffers[index];
+        if(buffer->has_damage && framebuffer->front >= 0 && framebuffer->front != index) {
+            const swl_uint8 *source = (const swl_uint8 *)framebuffer->buffers[framebuffer->front].pixels;
+            swl_uint8 *destination = (swl_uint8 *)buffer->pixels;
+            swl_uint32 offset = (swl_uint32)buffer->damage_x0 * 4;
+            swl_uint32 size = (swl_uint32)(buffer->damage_x1 - buffer->damage_x0) * 4;
+            for(int y = buffer->damage_y0; y < buffer->damage_y1; ++y) {
+                swl_uint32 row = (swl_uint32)y * framebuffer->stride + offset;
+                swl_memcpy(destination + row, source + row, size);
+            }
+        }
+        buffer->has_damage = SWL_FALSE;
+        framebuffer->acquired = index;
+    }
+
+    if(stride) *stride = framebuffer->stride;
+    return framebuffer->buffers[framebuffer->acquired].pixels;
+}
+
+void swl_present_framebuffer(swl_framebuffer *framebuffer, const swl_rect *rects, swl_uint32 rect_count)
+{
+    if(!framebuffer || framebuffer->acquired < 0) {
+        SWL_LOG_MESSAGE("No acquired framebuffer passed at swl_present_framebuffer");
+        return;
+    }
+
+    // Bounding box of the update, later copied into the other buffers on acquire
+    int index = framebuffer->acquired;
+    int x0 = (int)framebuffer->width, y0 = (int)framebuffer->height, x1 = 0, y1 = 0;
+    swl_rect whole = { 0, 0, framebuffer->width, framebuffer->height };
+    for(swl_uint32 i = 0; i < (rect_count ? rect_count : 1); ++i) {
+        int x, y, width, height;
+        if(!swl_clip_framebuffer_rect(framebuffer, rect_count ? &rects[i] : &whole, &x, &y, &width, &height))
+            continue;
+        if(x < x0) x0 = x;
+        if(y < y0) y0 = y;
+        if(x + width > x1) x1 = x + width;
+        if(y + height > y1) y1 = y + height;
+    }
+    for(swl_uint32 i = 0; i < framebuffer->buffer_count && x0 < x1 && y0 < y1; ++i) {
+        swl_framebuffer_buffer *buffer = &framebuffer->buffers[i];
+        if((int)i == index) continue;
+        if(!buffer->has_damage) {
+            buffer->damage_x0 = x0;
+            buffer->damage_y0 = y0;
+            buffer->damage_x1 = x1;
+            buffer->damage_y1 = y1;
+            buffer->has_damage = SWL_TRUE;
+            continue;
+        }
+        if(x0 < buffer->damage_x0) buffer->damage_x0 = x0;
+        if(y0 < buffer->damage_y0) buffer->damage_y0 = y0;
+        if(x1 > buffer->damage_x1) buffer->damage_x1 = x1;
+        if(y1 > buffer->damage_y1) buffer->damage_y1 = y1;
+    }
+
+    swl_present_framebuffer__platform(framebuffer, index, rects, rect_count);
+    framebuffer->front = index;
+    framebuffer->acquired = -1;
+}
+
+swl_bool swl_is_framebuffer_shared(const swl_framebuffer *framebuffer)
+{
+    return framebuffer ? framebuffer->is_shared : SWL_FALSE;
 }
 
 #endif // SWL_IMPLEMENTATION